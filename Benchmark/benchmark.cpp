@@ -1,6 +1,7 @@
 #include <benchmark/benchmark.h>
 
 #include <string>
+#include <cstdio>
 #include <gSparse/gSparse.hpp>
 
 static void BM_ApproxER_C100(benchmark::State& state) {
@@ -39,6 +40,33 @@ static void BM_ApproxER_C3000(benchmark::State& state) {
 }
 BENCHMARK(BM_ApproxER_C3000);
 
+static void BM_ApproxER_C3000_Implicit(benchmark::State& state) {
+  auto graph = gSparse::Builder::buildImplicitCompleteGraph(3000);
+    gSparse::PrecisionRowMatrix er;
+    gSparse::ER::ApproximateER approxER;
+  for (auto _ : state)
+    approxER.CalculateER(er, graph );
+}
+BENCHMARK(BM_ApproxER_C3000_Implicit);
+
+static void BM_ApproxERSPL_C1000(benchmark::State& state) {
+  auto graph = gSparse::Builder::buildUnitCompleteGraph(1000);
+    gSparse::PrecisionRowMatrix er;
+    gSparse::ER::ApproximateERSPL approxER;
+  for (auto _ : state)
+    approxER.CalculateER(er, graph );
+}
+BENCHMARK(BM_ApproxERSPL_C1000);
+
+static void BM_ApproxERMixed_C1000(benchmark::State& state) {
+  auto graph = gSparse::Builder::buildUnitCompleteGraph(1000);
+    gSparse::PrecisionRowMatrix er;
+    gSparse::ER::ApproximateERMixed approxER;
+  for (auto _ : state)
+    approxER.CalculateER(er, graph );
+}
+BENCHMARK(BM_ApproxERMixed_C1000);
+
 static void BM_ExactER_C100(benchmark::State& state) {
   auto graph = gSparse::Builder::buildUnitCompleteGraph(100);
     gSparse::ER::ExactER exactER;
@@ -48,6 +76,105 @@ static void BM_ExactER_C100(benchmark::State& state) {
 }
 BENCHMARK(BM_ExactER_C100);
 
+static void BM_ExactER_C200_Threads(benchmark::State& state) {
+  auto graph = gSparse::Builder::buildUnitCompleteGraph(200);
+    gSparse::ER::ExactER exactER;
+    exactER.SetThreadCount(static_cast<std::size_t>(state.range(0)));
+    gSparse::PrecisionRowMatrix er;
+  for (auto _ : state)
+    exactER.CalculateER(er, graph );
+}
+BENCHMARK(BM_ExactER_C200_Threads)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+
+static void BM_ERSampling_C1000_Sparsify(benchmark::State& state) {
+  auto graph = gSparse::Builder::buildUnitCompleteGraph(1000);
+    gSparse::SpectralSparsifier::ERSampling sparsifier(graph, 4.0, 0.1);
+    sparsifier.Compute();
+  for (auto _ : state)
+    benchmark::DoNotOptimize(sparsifier.GetSparsifiedGraph());
+}
+BENCHMARK(BM_ERSampling_C1000_Sparsify);
+
+static void BM_ERSampling_C1000_SparsifyIndependent(benchmark::State& state) {
+  auto graph = gSparse::Builder::buildUnitCompleteGraph(1000);
+    gSparse::SpectralSparsifier::ERSampling sparsifier(graph, 4.0, 0.1);
+    sparsifier.SetSamplingMethod(gSparse::SpectralSparsifier::INDEPENDENT_SAMPLING);
+    sparsifier.Compute();
+  for (auto _ : state)
+    benchmark::DoNotOptimize(sparsifier.GetSparsifiedGraph());
+}
+BENCHMARK(BM_ERSampling_C1000_SparsifyIndependent);
+
+static void BM_UndirectedGraph_C2000_Laplacian(benchmark::State& state) {
+  auto complete = gSparse::Builder::buildUnitCompleteGraph(2000);
+    gSparse::UndirectedGraph graph(complete->GetEdgeList(), complete->GetWeightList());
+  for (auto _ : state)
+  {
+    graph.ReleaseLaplacianMatrix();
+    benchmark::DoNotOptimize(graph.GetLaplacianMatrix().nonZeros());
+  }
+}
+BENCHMARK(BM_UndirectedGraph_C2000_Laplacian);
+
+static void BM_GraphCSVWriter_C1000(benchmark::State& state) {
+  auto graph = gSparse::Builder::buildRandomCompleteGraph(1000, 0.1, 10.0);
+    gSparse::GraphCSVWriter writer("bm-edges.csv", "bm-weights.csv");
+  for (auto _ : state)
+    writer.Write(graph);
+  std::remove("bm-edges.csv");
+  std::remove("bm-weights.csv");
+}
+BENCHMARK(BM_GraphCSVWriter_C1000);
+
+static void BM_GraphCSVReader_C1000(benchmark::State& state) {
+  auto graph = gSparse::Builder::buildRandomCompleteGraph(1000, 0.1, 10.0);
+    gSparse::GraphCSVWriter writer("bm-edges.csv", "bm-weights.csv");
+    writer.Write(graph);
+    gSparse::GraphCSVReader reader("bm-edges.csv", "bm-weights.csv");
+    reader.SetThreadCount(static_cast<std::size_t>(state.range(0)));
+    gSparse::EdgeMatrix edges;
+    gSparse::PrecisionRowMatrix weights;
+  for (auto _ : state)
+    reader.Read(edges, weights);
+  std::remove("bm-edges.csv");
+  std::remove("bm-weights.csv");
+}
+BENCHMARK(BM_GraphCSVReader_C1000)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+
+static void BM_GraphBinaryReader_C1000_Load(benchmark::State& state) {
+  auto graph = gSparse::Builder::buildRandomCompleteGraph(1000, 0.1, 10.0);
+    gSparse::GraphBinaryWriter writer("bm-graph.bin");
+    writer.Write(graph);
+    gSparse::GraphBinaryReader reader("bm-graph.bin");
+  for (auto _ : state)
+    benchmark::DoNotOptimize(reader.Load()->GetEdgeCount());
+  std::remove("bm-graph.bin");
+}
+BENCHMARK(BM_GraphBinaryReader_C1000_Load);
+
+static void BM_GraphCSVStreamReader_C1000(benchmark::State& state) {
+  auto graph = gSparse::Builder::buildRandomCompleteGraph(1000, 0.1, 10.0);
+    gSparse::GraphCSVWriter writer("bm-edges.csv", "bm-weights.csv");
+    writer.Write(graph);
+    gSparse::GraphCSVStreamReader reader("bm-edges.csv", "bm-weights.csv");
+  for (auto _ : state)
+    benchmark::DoNotOptimize(reader.ForEachBatch([](const gSparse::EdgeMatrix &, const gSparse::PrecisionRowMatrix &) {}));
+  std::remove("bm-edges.csv");
+  std::remove("bm-weights.csv");
+}
+BENCHMARK(BM_GraphCSVStreamReader_C1000);
+
+static void BM_GraphBinaryStreamReader_C1000(benchmark::State& state) {
+  auto graph = gSparse::Builder::buildRandomCompleteGraph(1000, 0.1, 10.0);
+    gSparse::GraphBinaryWriter writer("bm-graph.bin");
+    writer.Write(graph);
+    gSparse::GraphBinaryStreamReader reader("bm-graph.bin");
+  for (auto _ : state)
+    benchmark::DoNotOptimize(reader.ForEachBatch([](const gSparse::EdgeMatrix &, const gSparse::PrecisionRowMatrix &) {}));
+  std::remove("bm-graph.bin");
+}
+BENCHMARK(BM_GraphBinaryStreamReader_C1000);
+
 static void BM_StringCreation(benchmark::State& state) {
   for (auto _ : state)
     std::string empty_string;
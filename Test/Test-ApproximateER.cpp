@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 #include <gSparse/UndirectedGraph.hpp>
 #include <gSparse/ER/ApproximateER.hpp>
+#include <gSparse/Builder/CompleteGraph.hpp>
 
 #include <iostream>
 TEST(ApproximateER,JACOBI_CG)
@@ -24,6 +25,117 @@ TEST(ApproximateER,JACOBI_CG)
     EXPECT_NO_THROW(testPolicy.CalculateER(er,test));
 }
 
+TEST(ApproximateER,JACOBI_CG_FosterTheorem)
+{
+    // Foster's theorem: the sum of weighted effective resistances equals n - 1.
+    // Each JL estimate is noisy, but the sum over all edges should be close.
+    auto test = gSparse::Builder::buildUnitCompleteGraph(40);
+    gSparse::ER::ApproximateER testPolicy;
+    gSparse::PrecisionRowMatrix er;
+    EXPECT_EQ(gSparse::SUCCESSFUL, testPolicy.CalculateER(er,test));
+    ASSERT_EQ(test->GetEdgeCount(), er.rows());
+    EXPECT_NEAR(39.0, er.sum(), 39.0 * 0.4);
+}
+
+TEST(ApproximateER,ThreadCount)
+{
+    auto test = gSparse::Builder::buildUnitCompleteGraph(100);
+    gSparse::PrecisionRowMatrix er;
+
+    gSparse::ER::ApproximateER approxER;
+    EXPECT_EQ(0, approxER.GetThreadCount());
+    approxER.SetThreadCount(2);
+    EXPECT_EQ(2, approxER.GetThreadCount());
+    EXPECT_EQ(gSparse::SUCCESSFUL, approxER.CalculateER(er,test));
+    EXPECT_NEAR(99.0, er.sum(), 99.0 * 0.4);
+}
+
+TEST(ApproximateER,Seed)
+{
+    auto test = gSparse::Builder::buildUnitCompleteGraph(40);
+    gSparse::PrecisionRowMatrix first, second;
+
+    gSparse::ER::ApproximateER approxER;
+    approxER.SetSeed(11);
+    EXPECT_EQ(11, approxER.GetSeed());
+    approxER.CalculateER(first, test);
+    // The seed can also be set through the interface
+    gSparse::EffectiveResistance other = std::make_shared<gSparse::ER::ApproximateER>();
+    other->SetSeed(11);
+    other->CalculateER(second, test);
+    EXPECT_TRUE(first == second);
+}
+
+TEST(ApproximateER,SPL_Seed)
+{
+    // The seed also drives the randomized approximate Cholesky preconditioner
+    auto test = gSparse::Builder::buildRandomCompleteGraph(40, 1.0, 5.0);
+    gSparse::PrecisionRowMatrix first, second;
+    gSparse::ER::ApproximateERSPL approxER;
+    approxER.SetSeed(11);
+    approxER.CalculateER(first, test);
+    gSparse::ER::ApproximateERSPL other;
+    other.SetSeed(11);
+    other.CalculateER(second, test);
+    EXPECT_TRUE(first == second);
+}
+
+TEST(ApproximateER,PreconditionedCG_FosterTheorem)
+{
+    auto test = gSparse::Builder::buildUnitCompleteGraph(40);
+    gSparse::PrecisionRowMatrix er;
+
+    gSparse::ER::ApproximateERIncompleteCholesky ichol;
+    EXPECT_EQ(gSparse::SUCCESSFUL, ichol.CalculateER(er,test));
+    EXPECT_NEAR(39.0, er.sum(), 39.0 * 0.4);
+
+    gSparse::ER::ApproximateERSpanningTree tree;
+    EXPECT_EQ(gSparse::SUCCESSFUL, tree.CalculateER(er,test));
+    EXPECT_NEAR(39.0, er.sum(), 39.0 * 0.4);
+
+    gSparse::ER::ApproximateERAMG amg;
+    EXPECT_EQ(gSparse::SUCCESSFUL, amg.CalculateER(er,test));
+    EXPECT_NEAR(39.0, er.sum(), 39.0 * 0.4);
+
+    gSparse::ER::ApproximateERSPL spl;
+    EXPECT_EQ(gSparse::SUCCESSFUL, spl.CalculateER(er,test));
+    EXPECT_NEAR(39.0, er.sum(), 39.0 * 0.4);
+}
+
+TEST(ApproximateER,MixedPrecision)
+{
+    // Weights such as 1.1 are not exact in float, so refinement is needed to reach the tolerance
+    const std::size_t side = 12;
+    gSparse::EdgeMatrix Edges(2 * side * (side - 1), 2);
+    gSparse::PrecisionRowMatrix Weights(2 * side * (side - 1), 1);
+    std::size_t row = 0;
+    for (std::size_t i = 0; i != side; ++i)
+    {
+        for (std::size_t j = 0; j != side; ++j)
+        {
+            std::size_t node = i * side + j;
+            if (j + 1 != side) { Edges(row, 0) = node; Edges(row, 1) = node + 1; Weights(row++, 0) = 1.0 + 0.1 * (node % 3); }
+            if (i + 1 != side) { Edges(row, 0) = node; Edges(row, 1) = node + side; Weights(row++, 0) = 1.0 + 0.3 * (node % 5); }
+        }
+    }
+    gSparse::Graph test = std::make_shared<gSparse::UndirectedGraph>(Edges, Weights);
+
+    gSparse::PrecisionRowMatrix full, mixed;
+    gSparse::ER::ApproximateER fullER;
+    fullER.SetSeed(5);
+    EXPECT_EQ(gSparse::SUCCESSFUL, fullER.CalculateER(full, test));
+
+    gSparse::ER::ApproximateERMixed mixedER;
+    mixedER.SetSeed(5);
+    mixedER.SetTolerance(1e-10);
+    EXPECT_EQ(gSparse::SUCCESSFUL, mixedER.CalculateER(mixed, test));
+#ifdef GSPARSE_TEST_DOUBLE_PRECISION
+    // Float storage only needs refinement to match a double solve
+    EXPECT_GE(mixedER.GetRefinements(), 1);
+    EXPECT_LT((full - mixed).norm(), 1e-8 * full.norm());
+#endif
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
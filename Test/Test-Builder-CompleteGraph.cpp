@@ -26,3 +26,14 @@ TEST(Builder, CompleteRandomGraph)
 	//std::cout<<gSparse::Builder::buildRandomCompleteGraph(4,0.0,5.0)->GetWeightList()<<std::endl;
 }
 
+TEST(Builder, CompleteRandomGraphSeed)
+{
+	auto a = gSparse::Builder::buildRandomCompleteGraph(10, 1.0, 5.0, 42);
+	auto b = gSparse::Builder::buildRandomCompleteGraph(10, 1.0, 5.0, 42);
+	auto c = gSparse::Builder::buildRandomCompleteGraph(10, 1.0, 5.0, 43);
+	EXPECT_TRUE(a->GetWeightList() == b->GetWeightList());
+	EXPECT_FALSE(a->GetWeightList() == c->GetWeightList());
+	EXPECT_GE(a->GetWeightList().minCoeff(), 1.0);
+	EXPECT_LT(a->GetWeightList().maxCoeff(), 5.0);
+}
+
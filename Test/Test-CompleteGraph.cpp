@@ -0,0 +1,95 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <gtest/gtest.h>
+#include <gSparse/CompleteGraph.hpp>
+#include <gSparse/Builder/CompleteGraph.hpp>
+#include <gSparse/ER/ApproximateER.hpp>
+#include <gSparse/ER/ExactER.hpp>
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <memory>
+
+TEST(CompleteGraph, Counts)
+{
+    gSparse::CompleteGraph graph(7);
+    EXPECT_EQ(graph.GetNodeCount(), 7u);
+    EXPECT_EQ(graph.GetEdgeCount(), 21u);
+    EXPECT_EQ(graph.GetWeight(), 1.0);
+    EXPECT_FALSE(graph.IsMaterialized());
+    EXPECT_THROW(gSparse::CompleteGraph(1), std::invalid_argument);
+    EXPECT_THROW(gSparse::CompleteGraph(5, 0), std::invalid_argument);
+}
+TEST(CompleteGraph, EdgeIndex)
+{
+    // Edges are in the order of buildUnitCompleteGraph
+    const std::size_t n = 50;
+    gSparse::CompleteGraph graph(n);
+    gSparse::Graph explicitGraph = gSparse::Builder::buildUnitCompleteGraph(n);
+    const gSparse::EdgeList edges = explicitGraph->GetEdgeList();
+    for (std::size_t k = 0; k != graph.GetEdgeCount(); ++k)
+    {
+        std::pair<std::size_t, std::size_t> edge = graph.EdgeAt(k);
+        ASSERT_EQ(edge.first, edges(k, 0));
+        ASSERT_EQ(edge.second, edges(k, 1));
+        ASSERT_EQ(graph.EdgeIndex(edge.first, edge.second), k);
+        ASSERT_EQ(graph.EdgeIndex(edge.second, edge.first), k);
+    }
+
+    // Row boundaries of a graph too large to materialize
+    gSparse::CompleteGraph large(3000000);
+    for (std::size_t i : { std::size_t(0), std::size_t(1), std::size_t(1234567), std::size_t(2999998) })
+    {
+        for (std::size_t j : { i + 1, std::size_t(2999999) })
+        {
+            std::size_t k = large.EdgeIndex(i, j);
+            EXPECT_EQ(large.EdgeAt(k), std::make_pair(i, j));
+        }
+    }
+    EXPECT_EQ(large.EdgeIndex(2999998, 2999999), large.GetEdgeCount() - 1);
+    EXPECT_FALSE(large.IsMaterialized());
+}
+TEST(CompleteGraph, ApplyLaplacian)
+{
+    gSparse::CompleteGraph graph(30, 2.5);
+    gSparse::PrecisionMatrix x = gSparse::PrecisionMatrix::Random(30, 3);
+    gSparse::PrecisionMatrix implicitProduct = graph.ApplyLaplacian(x);
+    gSparse::PrecisionVector column = graph.ApplyLaplacian(x.col(1));
+    EXPECT_FALSE(graph.IsMaterialized());
+
+    // The IGraph getters materialize the graph
+    gSparse::PrecisionMatrix explicitProduct = graph.GetLaplacianMatrix() * x;
+    EXPECT_TRUE(graph.IsMaterialized());
+    EXPECT_LT((implicitProduct - explicitProduct).norm(), 1e-5 * explicitProduct.norm());
+    EXPECT_LT((column - explicitProduct.col(1)).norm(), 1e-5 * column.norm());
+    EXPECT_EQ(graph.GetEdgeList().rows(), 435);
+    EXPECT_TRUE(graph.GetWeightList() == gSparse::PrecisionRowMatrix::Constant(435, 1, 2.5));
+    EXPECT_EQ(gSparse::PrecisionMatrix(graph.GetDegreeMatrix()).diagonal().minCoeff(), 29 * 2.5);
+}
+TEST(CompleteGraph, ClosedFormER)
+{
+    gSparse::Graph graph = gSparse::Builder::buildImplicitCompleteGraph(40, 2.0);
+    const gSparse::CompleteGraph & complete = static_cast<const gSparse::CompleteGraph &>(*graph);
+    gSparse::PrecisionRowMatrix er;
+    gSparse::ER::ApproximateER approximate;
+    EXPECT_EQ(approximate.CalculateER(er, graph), gSparse::SUCCESSFUL);
+    EXPECT_TRUE(er == gSparse::PrecisionRowMatrix::Constant(780, 1, 2.0 / (40 * 2.0)));
+    gSparse::ER::ExactER exact;
+    EXPECT_EQ(exact.CalculateER(er, graph), gSparse::SUCCESSFUL);
+    EXPECT_TRUE(er == gSparse::PrecisionRowMatrix::Constant(780, 1, 2.0 / (40 * 2.0)));
+    EXPECT_FALSE(complete.IsMaterialized());
+
+    // The closed form is the exact effective resistance of the explicit graph
+    gSparse::Graph explicitGraph = gSparse::Builder::buildUnitCompleteGraph(40);
+    gSparse::PrecisionRowMatrix exactER;
+    exact.CalculateER(exactER, explicitGraph);
+    EXPECT_LT((exactER - gSparse::PrecisionRowMatrix::Constant(780, 1, 2.0 / 40)).cwiseAbs().maxCoeff(), 1e-6);
+    EXPECT_FALSE(gSparse::closedFormER(er, explicitGraph));
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -9,6 +9,11 @@
 #include <gSparse/Builder/CompleteGraph.hpp>
 
 #include <iostream>
+#include <limits>
+
+// Error of a direct solve of a small graph in the working precision
+static const double tolerance = 1000 * std::numeric_limits<gSparse::PRECISION>::epsilon();
+
 TEST(ExactER,JACOBI_CG)
 {
     // Call constructors
@@ -34,6 +39,115 @@ TEST(ExactER,JACOBI_CG)
     EXPECT_NO_THROW(testPolicy.CalculateER(er,test));
 }
 
+TEST(ExactER,LDLT_PathGraph)
+{
+    // Every edge of a path is a bridge. Its resistance is the inverse of its weight.
+    gSparse::EdgeMatrix Edges(3, 2);
+	gSparse::PrecisionMatrix Weights(3, 1);
+	Edges(0, 0) = 0; Edges(0, 1) = 1;
+	Edges(1, 0) = 1; Edges(1, 1) = 2;
+	Edges(2, 0) = 2; Edges(2, 1) = 3;
+	Weights << 1, 2, 4;
+
+    gSparse::Graph test(new gSparse::UndirectedGraph(Edges, Weights));
+    gSparse::ER::ExactER testPolicy;
+    gSparse::PrecisionRowMatrix er;
+    EXPECT_EQ(gSparse::SUCCESSFUL, testPolicy.CalculateER(er,test));
+    ASSERT_EQ(3, er.rows());
+    EXPECT_NEAR(1.0, er(0), tolerance);
+    EXPECT_NEAR(0.5, er(1), tolerance);
+    EXPECT_NEAR(0.25, er(2), tolerance);
+}
+
+TEST(ExactER,LDLT_CompleteGraph)
+{
+    // Effective resistance of every edge of a unit complete graph is 2/n
+    auto test = gSparse::Builder::buildUnitCompleteGraph(10);
+    gSparse::ER::ExactER testPolicy;
+    gSparse::PrecisionRowMatrix er;
+    EXPECT_EQ(gSparse::SUCCESSFUL, testPolicy.CalculateER(er,test));
+    for (std::size_t i = 0; i != test->GetEdgeCount(); ++i)
+        EXPECT_NEAR(0.2, er(i), tolerance);
+}
+
+TEST(ExactER,LDLT_Disconnected)
+{
+    // Two triangles with no edges in between. Each component is grounded separately.
+    gSparse::EdgeMatrix Edges(6, 2);
+	Edges(0, 0) = 0; Edges(0, 1) = 1;
+	Edges(1, 0) = 1; Edges(1, 1) = 2;
+	Edges(2, 0) = 2; Edges(2, 1) = 0;
+	Edges(3, 0) = 3; Edges(3, 1) = 4;
+	Edges(4, 0) = 4; Edges(4, 1) = 5;
+	Edges(5, 0) = 5; Edges(5, 1) = 3;
+
+    gSparse::Graph test(new gSparse::UndirectedGraph(Edges));
+    gSparse::ER::ExactER testPolicy;
+    gSparse::PrecisionRowMatrix er;
+    EXPECT_EQ(gSparse::SUCCESSFUL, testPolicy.CalculateER(er,test));
+    for (std::size_t i = 0; i != test->GetEdgeCount(); ++i)
+        EXPECT_NEAR(2.0 / 3.0, er(i), tolerance);
+}
+
+TEST(ExactER,JACOBI_CG_MatchesLDLT)
+{
+    auto test = gSparse::Builder::buildRandomCompleteGraph(12, 1.0, 5.0);
+    gSparse::ER::ExactER ldlt;
+    gSparse::ER::ExactERJacobiCG cg;
+    gSparse::PrecisionRowMatrix erLDLT, erCG;
+    ldlt.CalculateER(erLDLT, test);
+    cg.CalculateER(erCG, test);
+    EXPECT_LT((erLDLT - erCG).norm() / erLDLT.norm(), 1e-6);
+}
+
+TEST(ExactER,ThreadCount)
+{
+    auto test = gSparse::Builder::buildRandomCompleteGraph(30, 1.0, 5.0);
+    gSparse::PrecisionRowMatrix erSerial, er;
+
+    gSparse::ER::ExactER ldlt;
+    EXPECT_EQ(0, ldlt.GetThreadCount());
+    ldlt.SetThreadCount(1);
+    EXPECT_EQ(1, ldlt.GetThreadCount());
+    ldlt.CalculateER(erSerial, test);
+    // Thread counts that do and do not divide the edge count evenly
+    for (std::size_t threads : {2, 4, 7})
+    {
+        ldlt.SetThreadCount(threads);
+        EXPECT_EQ(gSparse::SUCCESSFUL, ldlt.CalculateER(er, test));
+        EXPECT_LT((erSerial - er).norm() / erSerial.norm(), 1e-12);
+    }
+
+    gSparse::ER::ExactERJacobiCG cg;
+    cg.SetThreadCount(3);
+    EXPECT_EQ(gSparse::SUCCESSFUL, cg.CalculateER(er, test));
+    EXPECT_LT((erSerial - er).norm() / erSerial.norm(), 1e-6);
+}
+
+TEST(ExactER,PreconditionedCG_MatchesLDLT)
+{
+    auto test = gSparse::Builder::buildRandomCompleteGraph(12, 1.0, 5.0);
+    gSparse::ER::ExactER ldlt;
+    gSparse::PrecisionRowMatrix erLDLT, er;
+    ldlt.CalculateER(erLDLT, test);
+
+    gSparse::ER::ExactERIncompleteCholesky ichol;
+    EXPECT_EQ(gSparse::SUCCESSFUL, ichol.CalculateER(er, test));
+    EXPECT_LT((erLDLT - er).norm() / erLDLT.norm(), 1e-6);
+
+    gSparse::ER::ExactERSpanningTree tree;
+    EXPECT_EQ(gSparse::SUCCESSFUL, tree.CalculateER(er, test));
+    EXPECT_LT((erLDLT - er).norm() / erLDLT.norm(), 1e-6);
+
+    gSparse::ER::ExactERAMG amg;
+    EXPECT_EQ(gSparse::SUCCESSFUL, amg.CalculateER(er, test));
+    EXPECT_LT((erLDLT - er).norm() / erLDLT.norm(), 1e-6);
+
+    gSparse::ER::ExactERApproximateCholesky chol;
+    EXPECT_EQ(gSparse::SUCCESSFUL, chol.CalculateER(er, test));
+    EXPECT_LT((erLDLT - er).norm() / erLDLT.norm(), 1e-6);
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
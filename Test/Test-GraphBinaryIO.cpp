@@ -0,0 +1,131 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <gtest/gtest.h>
+#include <gSparse/GraphBinaryWriter.hpp>
+#include <gSparse/GraphBinaryReader.hpp>
+#include <gSparse/Builder/CompleteGraph.hpp>
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <memory>
+#include <string>
+#include <fstream>
+#include <cstdio>
+#include <cstdint>
+
+/*******************************************************
+ * Test Cases
+ * ******************************************************/
+TEST(GraphBinaryIO, RoundTrip)
+{
+    gSparse::Graph graph = gSparse::Builder::buildRandomCompleteGraph(30, 0.5, 2.0, 7);
+    gSparse::PrecisionRowMatrix er = graph->GetWeightList().cwiseInverse();
+    gSparse::GraphBinaryWriter writer("test-graph.bin", true);
+    writer.Write(graph, er);
+
+    gSparse::GraphBinaryReader reader("test-graph.bin");
+    gSparse::EdgeMatrix Edges;
+    gSparse::PrecisionRowMatrix Weight;
+    reader.Read(Edges, Weight);
+    EXPECT_TRUE(Edges == graph->GetEdgeList());
+    EXPECT_TRUE(Weight == graph->GetWeightList());
+
+    gSparse::SparsePrecisionMatrix Laplacian;
+    ASSERT_TRUE(reader.ReadLaplacian(Laplacian));
+    EXPECT_EQ((gSparse::PrecisionMatrix(Laplacian) - gSparse::PrecisionMatrix(graph->GetLaplacianMatrix())).norm(), 0.0);
+    gSparse::PrecisionRowMatrix storedER;
+    ASSERT_TRUE(reader.ReadER(storedER));
+    EXPECT_TRUE(storedER == er);
+    std::remove("test-graph.bin");
+}
+TEST(GraphBinaryIO, LoadMapped)
+{
+    gSparse::Graph graph = gSparse::Builder::buildRandomCompleteGraph(20, 0.5, 2.0, 11);
+    gSparse::GraphBinaryWriter writer("test-graph.bin");
+    writer.SetIncludeLaplacian(true);
+    writer.Write(graph);
+
+    gSparse::Graph loaded = gSparse::GraphBinaryReader("test-graph.bin").Load();
+    // Removing the file keeps the mapping of the loaded graph valid
+    std::remove("test-graph.bin");
+    std::shared_ptr<gSparse::UndirectedGraph> mapped = std::dynamic_pointer_cast<gSparse::MappedUndirectedGraph>(loaded);
+    ASSERT_NE(mapped, nullptr);
+    EXPECT_TRUE(mapped->HasLaplacianMatrix());
+    EXPECT_EQ(loaded->GetNodeCount(), graph->GetNodeCount());
+    EXPECT_EQ(loaded->GetEdgeCount(), graph->GetEdgeCount());
+    EXPECT_TRUE(loaded->GetEdgeList() == graph->GetEdgeList());
+    EXPECT_TRUE(loaded->GetWeightList() == graph->GetWeightList());
+    EXPECT_EQ((gSparse::PrecisionMatrix(loaded->GetLaplacianMatrix()) - gSparse::PrecisionMatrix(graph->GetLaplacianMatrix())).norm(), 0.0);
+    EXPECT_EQ((gSparse::PrecisionMatrix(loaded->GetAdjacentMatrix()) - gSparse::PrecisionMatrix(graph->GetAdjacentMatrix())).norm(), 0.0);
+}
+TEST(GraphBinaryIO, EdgesOnly)
+{
+    gSparse::EdgeMatrix Edges_Validate(3, 2);
+    Edges_Validate << 1, 2, 2, 3, 3, 1;
+    gSparse::GraphBinaryWriter("test-graph.bin").Write(Edges_Validate);
+
+    gSparse::GraphBinaryReader reader("test-graph.bin");
+    gSparse::EdgeMatrix Edges;
+    gSparse::PrecisionRowMatrix Weight;
+    reader.Read(Edges, Weight);
+    gSparse::SparsePrecisionMatrix Laplacian;
+    gSparse::PrecisionRowMatrix er;
+    EXPECT_FALSE(reader.ReadLaplacian(Laplacian));
+    EXPECT_FALSE(reader.ReadER(er));
+    std::remove("test-graph.bin");
+    EXPECT_TRUE(Edges == Edges_Validate);
+    EXPECT_TRUE(Weight == gSparse::PrecisionRowMatrix::Ones(3, 1));
+}
+TEST(GraphBinaryIO, ConvertSizes)
+{
+    // A file written with 64-bit node indices and float weights
+    gSparse::Util::BinaryGraphHeader header = gSparse::Util::BinaryGraphHeader::create(8, 4, 4);
+    header.nodeCount = 4;
+    header.edgeCount = 3;
+    const std::uint64_t edges[] = { 0, 1, 1, 2, 2, 3 };
+    const float weights[] = { 0.5f, 1.5f, 2.5f };
+    {
+        std::ofstream file("test-graph.bin", std::ios::binary);
+        std::string bytes(static_cast<std::size_t>(header.fileSize()), '\0');
+        std::memcpy(&bytes[0], &header, sizeof(header));
+        std::memcpy(&bytes[header.edgeOffset()], edges, sizeof(edges));
+        std::memcpy(&bytes[header.weightOffset()], weights, sizeof(weights));
+        file << bytes;
+    }
+    gSparse::Graph graph = gSparse::GraphBinaryReader("test-graph.bin").Load();
+    std::remove("test-graph.bin");
+    gSparse::EdgeMatrix Edges_Validate(3, 2);
+    Edges_Validate << 0, 1, 1, 2, 2, 3;
+    gSparse::PrecisionRowMatrix Weight_Validate(3, 1);
+    Weight_Validate << 0.5, 1.5, 2.5;
+    EXPECT_TRUE(graph->GetEdgeList() == Edges_Validate);
+    EXPECT_TRUE(graph->GetWeightList() == Weight_Validate);
+    EXPECT_EQ(graph->GetNodeCount(), 4u);
+}
+TEST(GraphBinaryIO, Invalid)
+{
+    gSparse::EdgeMatrix Edges;
+    gSparse::PrecisionRowMatrix Weight;
+    EXPECT_THROW(gSparse::GraphBinaryReader("ThisFileDoesNotExist.bin").Read(Edges, Weight), std::runtime_error);
+    EXPECT_THROW(gSparse::GraphBinaryReader("test-edges.csv").Read(Edges, Weight), std::runtime_error);
+
+    // A truncated file
+    gSparse::GraphBinaryWriter("test-graph.bin").Write(gSparse::Builder::buildUnitCompleteGraph(10));
+    {
+        std::ifstream in("test-graph.bin", std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        in.close();
+        std::ofstream out("test-graph.bin", std::ios::binary | std::ios::trunc);
+        out << bytes.substr(0, bytes.size() - 8);
+    }
+    EXPECT_THROW(gSparse::GraphBinaryReader("test-graph.bin").Load(), std::runtime_error);
+    std::remove("test-graph.bin");
+
+    EXPECT_THROW(gSparse::GraphBinaryWriter("test-graph.bin").Write(gSparse::Graph()), std::invalid_argument);
+}
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
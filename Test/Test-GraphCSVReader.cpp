@@ -4,9 +4,16 @@
 
 #include <gtest/gtest.h>
 #include <gSparse/GraphCSVReader.hpp>
+#include <gSparse/Util/CSVParser.hpp>
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
 #include <memory>
+#include <fstream>
+#include <string>
+#include <cstdlib>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
 
 /*******************************************************
  * Test Cases
@@ -77,6 +84,115 @@ TEST(GraphCSVReader, AllNotFound)
 	gSparse::GraphCSVReader csvReaderFail("ThisFileDoesNotExist.txt", "ThisFileDoesNotExist.txt", " ");
 	EXPECT_ANY_THROW(csvReaderFail.Read(Edges, Weight));
 }
+TEST(GraphCSVReader, ParseFormats)
+{
+    // Comma delimiter, CRLF, blank lines, spaces around cells, integers written as reals, no trailing newline
+    {
+        std::ofstream file("test-format-edges.csv", std::ios::binary);
+        file << "0,1\r\n\r\n 1 , 2\r\n2.0,3e0\n\n3,0";
+    }
+    const char * weights[] = { "0.1", "-2.5e-3", "1.7976931348623157e308", "0.30000000000000004441" };
+    {
+        std::ofstream file("test-format-weights.csv", std::ios::binary);
+        for (const char * w : weights) file << w << "\n";
+    }
+    gSparse::GraphCSVReader csvReader("test-format-edges.csv", "test-format-weights.csv", ",");
+    gSparse::EdgeMatrix Edges;
+    gSparse::PrecisionRowMatrix Weight;
+    csvReader.Read(Edges, Weight);
+    std::remove("test-format-edges.csv");
+    std::remove("test-format-weights.csv");
+
+    gSparse::EdgeMatrix Edges_Validate(4, 2);
+    Edges_Validate << 0, 1, 1, 2, 2, 3, 3, 0;
+    ASSERT_EQ(Edges.rows(), 4);
+    ASSERT_EQ(Edges.cols(), 2);
+    EXPECT_TRUE(Edges == Edges_Validate);
+    ASSERT_EQ(Weight.rows(), 4);
+    ASSERT_EQ(Weight.cols(), 1);
+    for (int i = 0; i != 4; ++i)
+        EXPECT_EQ(Weight(i), static_cast<gSparse::PRECISION>(std::strtod(weights[i], nullptr)));
+}
+TEST(GraphCSVReader, Malformed)
+{
+    gSparse::EdgeMatrix Edges;
+    gSparse::PrecisionRowMatrix Weight;
+    // Fractional indices are rejected rather than truncated
+    const char * files[] = { "0 1\n1\n", "0 1\n1 x\n", "0 1\n1 2 3\n", "0 -1\n", "0 99999999999\n", "0 3.7\n", "0 1e30\n" };
+    for (const char * contents : files)
+    {
+        {
+            std::ofstream file("test-malformed-edges.csv", std::ios::binary);
+            file << contents;
+        }
+        gSparse::GraphCSVReader csvReader("test-malformed-edges.csv", "None", " ");
+        EXPECT_THROW(csvReader.Read(Edges, Weight), std::runtime_error) << contents;
+    }
+    std::remove("test-malformed-edges.csv");
+}
+TEST(GraphCSVReader, IntegerBounds)
+{
+    auto parse = [](const char * text, std::uint64_t & value)
+    {
+        const char * cursor = text;
+        return gSparse::Util::parseNumber(cursor, text + std::strlen(text), ',', value);
+    };
+    std::uint64_t value = 0;
+    EXPECT_TRUE(parse("18446744073709551615", value));
+    EXPECT_EQ(UINT64_MAX, value);
+    EXPECT_TRUE(parse("3.0", value));
+    EXPECT_EQ(3u, value);
+    // One past the maximum, and a value that wraps around to a small number when multiplied
+    EXPECT_FALSE(parse("18446744073709551616", value));
+    EXPECT_FALSE(parse("36893488147419103233", value));
+    EXPECT_FALSE(parse("3.7", value));
+    EXPECT_FALSE(parse("1.8446744073709552e19", value));
+}
+TEST(GraphCSVReader, ParallelChunks)
+{
+    // Blank lines are scattered so that some chunks hold fewer rows than lines
+    const int rows = 20000;
+    {
+        std::ofstream edges("test-parallel-edges.csv", std::ios::binary);
+        std::ofstream weights("test-parallel-weights.csv", std::ios::binary);
+        for (int i = 0; i != rows; ++i)
+        {
+            edges << i << "," << (i * 7 + 3) % rows << "\n";
+            weights << 0.5 + i * 0.25 << "\n";
+            if (i % 997 == 0) { edges << "\n"; weights << "\r\n"; }
+        }
+    }
+    gSparse::GraphCSVReader serial("test-parallel-edges.csv", "test-parallel-weights.csv", ",");
+    serial.SetThreadCount(1);
+    gSparse::EdgeMatrix Edges_Validate;
+    gSparse::PrecisionRowMatrix Weight_Validate;
+    serial.Read(Edges_Validate, Weight_Validate);
+    ASSERT_EQ(Edges_Validate.rows(), rows);
+    EXPECT_EQ(Edges_Validate(rows - 1, 0), static_cast<gSparse::NodeIndex>(rows - 1));
+    EXPECT_EQ(Weight_Validate(rows - 1), 0.5 + (rows - 1) * 0.25);
+
+    for (std::size_t threads : { 2, 3, 8 })
+    {
+        gSparse::GraphCSVReader parallel("test-parallel-edges.csv", "test-parallel-weights.csv", ",");
+        parallel.SetThreadCount(threads, 1024);
+        gSparse::EdgeMatrix Edges;
+        gSparse::PrecisionRowMatrix Weight;
+        parallel.Read(Edges, Weight);
+        EXPECT_TRUE(Edges == Edges_Validate) << threads;
+        EXPECT_TRUE(Weight == Weight_Validate) << threads;
+    }
+
+    // A malformed row in a late chunk is still reported
+    {
+        std::ofstream edges("test-parallel-edges.csv", std::ios::binary | std::ios::app);
+        edges << "1,2,3\n";
+    }
+    gSparse::GraphCSVReader parallel("test-parallel-edges.csv", "None", ",");
+    parallel.SetThreadCount(4, 1024);
+    EXPECT_THROW(parallel.Read(Edges_Validate, Weight_Validate), std::runtime_error);
+    std::remove("test-parallel-edges.csv");
+    std::remove("test-parallel-weights.csv");
+}
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -4,11 +4,15 @@
 
 #include <gtest/gtest.h>
 #include <gSparse/GraphCSVWriter.hpp>
+#include <gSparse/GraphCSVReader.hpp>
+#include <gSparse/Builder/CompleteGraph.hpp>
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
 #include <memory>
 #include <string>
 #include <fstream>
+#include <cstdio>
+#include <cmath>
 
 /*******************************************************
  * Set up and utility functions
@@ -71,13 +75,13 @@ public:
 	{
 		return dummy;
 	}
-	const gSparse::EdgeMatrix & GetEdgeList() const 
+	gSparse::EdgeList GetEdgeList() const 
 	{
-		return dummyEdge;;
+		return gSparse::EdgeList(dummyEdge.data(), dummyEdge.rows(), dummyEdge.cols());
 	}
-	const gSparse::PrecisionRowMatrix & GetWeightList() const
+	gSparse::WeightList GetWeightList() const
 	{
-		return dummyWeight;
+		return gSparse::WeightList(dummyWeight.data(), dummyWeight.rows(), dummyWeight.cols());
 	}
 	std::size_t GetEdgeCount() const {
 		return 0;
@@ -103,7 +107,7 @@ TEST(GraphCSVWriter, Write1)
 	Edges(2, 0) = 3; Edges(2, 1) = 1;
 
     //Building weight validation data
-	Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>  Weight(3, 1);
+	gSparse::PrecisionMatrix  Weight(3, 1);
 	Weight << 1, 2, 3;
 
     // Write the file
@@ -216,6 +220,41 @@ TEST(GraphCSVWriter, WriteGraphError3)
 	EXPECT_ANY_THROW(csvWriter->Write(Edges, Weight));
 }
 
+TEST(GraphCSVWriter, RoundTrip)
+{
+    // Weights need up to 17 digits, and the lists span several output buffers
+    gSparse::Graph graph = gSparse::Builder::buildRandomCompleteGraph(500, 0.001, 1000.0, 5);
+    for (bool background : { false, true })
+    {
+        gSparse::GraphCSVWriter csvWriter("csvwriter-edges.csv", "csvwriter-weight.csv", ", ");
+        csvWriter.SetBackgroundWrite(background);
+        csvWriter.Write(graph);
+
+        gSparse::GraphCSVReader csvReader("csvwriter-edges.csv", "csvwriter-weight.csv", ",");
+        gSparse::EdgeMatrix Edges;
+        gSparse::PrecisionRowMatrix Weight;
+        csvReader.Read(Edges, Weight);
+        EXPECT_TRUE(Edges == graph->GetEdgeList()) << background;
+        EXPECT_TRUE(Weight == graph->GetWeightList()) << background;
+    }
+    std::remove("csvwriter-edges.csv");
+    std::remove("csvwriter-weight.csv");
+}
+TEST(GraphCSVWriter, ShortestNumbers)
+{
+    const gSparse::PRECISION values[] = { 0.1, 2.5, 100, -0.001, 1e-7, 123456.75 };
+    const char * expected[] = { "0.1", "2.5", "100", "-0.001", "1e-07", "123456.75" };
+    for (int i = 0; i != 6; ++i)
+    {
+        char text[gSparse::Util::MAX_NUMBER_CHARS];
+        const std::size_t length = gSparse::Util::formatNumber(text, values[i]);
+        EXPECT_EQ(std::string(text, length), expected[i]);
+    }
+    char text[gSparse::Util::MAX_NUMBER_CHARS];
+    EXPECT_EQ(std::string(text, gSparse::Util::formatNumber(text, gSparse::NodeIndex(4294967295u))), "4294967295");
+    EXPECT_EQ(std::string(text, gSparse::Util::formatNumber(text, std::uint64_t(0))), "0");
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,217 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <gtest/gtest.h>
+#include <gSparse/GraphMatrixMarketReader.hpp>
+#include <gSparse/GraphMatrixMarketWriter.hpp>
+#include <gSparse/GraphSNAPReader.hpp>
+#include <gSparse/GraphSNAPWriter.hpp>
+#include <gSparse/GraphMETISReader.hpp>
+#include <gSparse/GraphMETISWriter.hpp>
+#include <gSparse/UndirectedGraph.hpp>
+#include <gSparse/Builder/CompleteGraph.hpp>
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <memory>
+#include <string>
+#include <fstream>
+#include <cstdio>
+
+/*******************************************************
+ * Helpers
+ * ******************************************************/
+static void writeText(const std::string & path, const std::string & text)
+{
+    std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+    file << text;
+}
+// Write a graph and read it back, then compare Laplacians, which do not depend on edge order or direction
+static void expectRoundTrip(gSparse::IGraphWriter & writer, gSparse::IGraphReader & reader, const gSparse::Graph & graph)
+{
+    writer.Write(graph);
+    gSparse::EdgeMatrix Edges;
+    gSparse::PrecisionRowMatrix Weight;
+    reader.Read(Edges, Weight);
+    ASSERT_EQ(Edges.rows(), static_cast<Eigen::Index>(graph->GetEdgeCount()));
+    gSparse::UndirectedGraph loaded(Edges, Weight);
+    EXPECT_EQ(loaded.GetNodeCount(), graph->GetNodeCount());
+    EXPECT_EQ((gSparse::PrecisionMatrix(loaded.GetLaplacianMatrix()) - gSparse::PrecisionMatrix(graph->GetLaplacianMatrix())).norm(), 0.0);
+}
+
+/*******************************************************
+ * Test Cases
+ * ******************************************************/
+TEST(GraphFormats, RoundTrip)
+{
+    gSparse::Graph graph = gSparse::Builder::buildRandomCompleteGraph(40, 0.5, 2.0, 3);
+
+    gSparse::GraphMatrixMarketWriter mmWriter("test-graph.mtx");
+    gSparse::GraphMatrixMarketReader mmReader("test-graph.mtx");
+    expectRoundTrip(mmWriter, mmReader, graph);
+    std::remove("test-graph.mtx");
+
+    gSparse::GraphSNAPWriter snapWriter("test-graph.txt");
+    gSparse::GraphSNAPReader snapReader("test-graph.txt");
+    expectRoundTrip(snapWriter, snapReader, graph);
+    std::remove("test-graph.txt");
+
+    gSparse::GraphMETISWriter metisWriter("test-graph.graph");
+    gSparse::GraphMETISReader metisReader("test-graph.graph");
+    expectRoundTrip(metisWriter, metisReader, graph);
+    std::remove("test-graph.graph");
+}
+TEST(GraphFormats, EdgesOnly)
+{
+    gSparse::EdgeMatrix Edges_Validate(3, 2);
+    Edges_Validate << 0, 1, 1, 2, 0, 2;
+    gSparse::EdgeMatrix Edges;
+    gSparse::PrecisionRowMatrix Weight;
+
+    gSparse::GraphMatrixMarketWriter("test-graph.mtx").Write(Edges_Validate);
+    gSparse::GraphMatrixMarketReader("test-graph.mtx").Read(Edges, Weight);
+    std::remove("test-graph.mtx");
+    EXPECT_TRUE(Edges == (gSparse::EdgeMatrix(3, 2) << 1, 0, 2, 1, 2, 0).finished());
+    EXPECT_TRUE(Weight == gSparse::PrecisionRowMatrix::Ones(3, 1));
+
+    gSparse::GraphSNAPWriter("test-graph.txt").Write(Edges_Validate);
+    gSparse::GraphSNAPReader("test-graph.txt").Read(Edges, Weight);
+    std::remove("test-graph.txt");
+    EXPECT_TRUE(Edges == Edges_Validate);
+    EXPECT_TRUE(Weight == gSparse::PrecisionRowMatrix::Ones(3, 1));
+
+    gSparse::GraphMETISWriter("test-graph.graph").Write(Edges_Validate);
+    gSparse::GraphMETISReader("test-graph.graph").Read(Edges, Weight);
+    std::remove("test-graph.graph");
+    EXPECT_TRUE(Edges == (gSparse::EdgeMatrix(3, 2) << 0, 1, 0, 2, 1, 2).finished());
+    EXPECT_TRUE(Weight == gSparse::PrecisionRowMatrix::Ones(3, 1));
+}
+TEST(GraphFormats, MatrixMarket)
+{
+    writeText("test-graph.mtx",
+        "%%MatrixMarket matrix coordinate real symmetric\n"
+        "% A comment\n"
+        "%\n"
+        "4 4 5\n"
+        "1 1 9.0\n"
+        "2 1 0.5\n"
+        "3 2 1.5e0\n"
+        "\n"
+        "4 3   2\r\n"
+        "4 1 -0.25\n");
+    gSparse::EdgeMatrix Edges;
+    gSparse::PrecisionRowMatrix Weight;
+    gSparse::GraphMatrixMarketReader("test-graph.mtx").Read(Edges, Weight);
+    gSparse::EdgeMatrix Edges_Validate(4, 2);
+    Edges_Validate << 1, 0, 2, 1, 3, 2, 3, 0;
+    gSparse::PrecisionRowMatrix Weight_Validate(4, 1);
+    Weight_Validate << 0.5, 1.5, 2.0, -0.25;
+    EXPECT_TRUE(Edges == Edges_Validate);
+    EXPECT_TRUE(Weight == Weight_Validate);
+
+    writeText("test-graph.mtx", "%%MatrixMarket matrix coordinate real general\n2 2 1\n2 1 1\n");
+    EXPECT_THROW(gSparse::GraphMatrixMarketReader("test-graph.mtx").Read(Edges, Weight), std::runtime_error);
+    writeText("test-graph.mtx", "%%MatrixMarket matrix array real symmetric\n2 2\n1\n2\n3\n");
+    EXPECT_THROW(gSparse::GraphMatrixMarketReader("test-graph.mtx").Read(Edges, Weight), std::runtime_error);
+    writeText("test-graph.mtx", "%%MatrixMarket matrix coordinate real symmetric\n2 2 2\n2 1 1\n");
+    EXPECT_THROW(gSparse::GraphMatrixMarketReader("test-graph.mtx").Read(Edges, Weight), std::runtime_error);
+    writeText("test-graph.mtx", "%%MatrixMarket matrix coordinate real symmetric\n2 2 1\n3 1 1\n");
+    EXPECT_THROW(gSparse::GraphMatrixMarketReader("test-graph.mtx").Read(Edges, Weight), std::runtime_error);
+    writeText("test-graph.mtx", "%%MatrixMarket matrix coordinate pattern symmetric\n2 2 1\n2 1 1\n");
+    EXPECT_THROW(gSparse::GraphMatrixMarketReader("test-graph.mtx").Read(Edges, Weight), std::runtime_error);
+    std::remove("test-graph.mtx");
+    EXPECT_THROW(gSparse::GraphMatrixMarketReader("ThisFileDoesNotExist.mtx").Read(Edges, Weight), std::runtime_error);
+}
+TEST(GraphFormats, SNAP)
+{
+    writeText("test-graph.txt",
+        "# Directed graph (each unordered pair of nodes is saved once)\n"
+        "# Nodes: 4 Edges: 3\n"
+        "# FromNodeId\tToNodeId\tWeight\n"
+        "0\t1\t0.5\n"
+        "\n"
+        "1 2  1.5\r\n"
+        "# A comment between edges\n"
+        "3\t0\t2");
+    gSparse::EdgeMatrix Edges;
+    gSparse::PrecisionRowMatrix Weight;
+    gSparse::GraphSNAPReader("test-graph.txt").Read(Edges, Weight);
+    gSparse::EdgeMatrix Edges_Validate(3, 2);
+    Edges_Validate << 0, 1, 1, 2, 3, 0;
+    gSparse::PrecisionRowMatrix Weight_Validate(3, 1);
+    Weight_Validate << 0.5, 1.5, 2.0;
+    EXPECT_TRUE(Edges == Edges_Validate);
+    EXPECT_TRUE(Weight == Weight_Validate);
+
+    writeText("test-graph.txt", "0 1\n1 2 1.5\n");
+    EXPECT_THROW(gSparse::GraphSNAPReader("test-graph.txt").Read(Edges, Weight), std::runtime_error);
+    writeText("test-graph.txt", "0 1 1\n1 2\n");
+    EXPECT_THROW(gSparse::GraphSNAPReader("test-graph.txt").Read(Edges, Weight), std::runtime_error);
+    writeText("test-graph.txt", "0 x\n");
+    EXPECT_THROW(gSparse::GraphSNAPReader("test-graph.txt").Read(Edges, Weight), std::runtime_error);
+    std::remove("test-graph.txt");
+    EXPECT_THROW(gSparse::GraphSNAPReader("ThisFileDoesNotExist.txt").Read(Edges, Weight), std::runtime_error);
+}
+TEST(GraphFormats, METIS)
+{
+    // Vertex sizes and two vertex weights precede the weighted neighbours, and vertex 4 has none
+    writeText("test-graph.graph",
+        "% A comment\n"
+        "5 4 111 2\n"
+        "1 7 8 2 0.5 3 1.5\n"
+        "% A comment between vertices\n"
+        "1 7 8 1 0.5 5 3\n"
+        "1 7 8 1 1.5 5 2\n"
+        "1 7 8\n"
+        "1 7 8 2 3 3 2\n");
+    gSparse::EdgeMatrix Edges;
+    gSparse::PrecisionRowMatrix Weight;
+    gSparse::GraphMETISReader("test-graph.graph").Read(Edges, Weight);
+    gSparse::EdgeMatrix Edges_Validate(4, 2);
+    Edges_Validate << 0, 1, 0, 2, 1, 4, 2, 4;
+    gSparse::PrecisionRowMatrix Weight_Validate(4, 1);
+    Weight_Validate << 0.5, 1.5, 3.0, 2.0;
+    EXPECT_TRUE(Edges == Edges_Validate);
+    EXPECT_TRUE(Weight == Weight_Validate);
+
+    // An unweighted triangle with a blank line for an isolated vertex
+    writeText("test-graph.graph", "4 3\n2 3\n1 3\n1 2\n\n");
+    gSparse::GraphMETISReader("test-graph.graph").Read(Edges, Weight);
+    EXPECT_TRUE(Edges == (gSparse::EdgeMatrix(3, 2) << 0, 1, 0, 2, 1, 2).finished());
+    EXPECT_TRUE(Weight == gSparse::PrecisionRowMatrix::Ones(3, 1));
+
+    writeText("test-graph.graph", "3 1\n2 3\n1\n1\n");
+    EXPECT_THROW(gSparse::GraphMETISReader("test-graph.graph").Read(Edges, Weight), std::runtime_error);
+    writeText("test-graph.graph", "2 1\n3\n1\n");
+    EXPECT_THROW(gSparse::GraphMETISReader("test-graph.graph").Read(Edges, Weight), std::runtime_error);
+    writeText("test-graph.graph", "2 1\n2\n1\n1\n");
+    EXPECT_THROW(gSparse::GraphMETISReader("test-graph.graph").Read(Edges, Weight), std::runtime_error);
+    writeText("test-graph.graph", "2 1 2\n2\n1\n");
+    EXPECT_THROW(gSparse::GraphMETISReader("test-graph.graph").Read(Edges, Weight), std::runtime_error);
+    std::remove("test-graph.graph");
+    EXPECT_THROW(gSparse::GraphMETISReader("ThisFileDoesNotExist.graph").Read(Edges, Weight), std::runtime_error);
+}
+TEST(GraphFormats, METISSelfLoops)
+{
+    gSparse::EdgeMatrix Edges_Validate(3, 2);
+    Edges_Validate << 0, 1, 1, 1, 1, 2;
+    gSparse::PrecisionRowMatrix Weight_Validate(3, 1);
+    Weight_Validate << 2.0, 5.0, 3.0;
+    gSparse::GraphMETISWriter("test-graph.graph").Write(Edges_Validate, Weight_Validate);
+    gSparse::EdgeMatrix Edges;
+    gSparse::PrecisionRowMatrix Weight;
+    gSparse::GraphMETISReader("test-graph.graph").Read(Edges, Weight);
+    std::ifstream file("test-graph.graph");
+    std::string header;
+    std::getline(file, header);
+    file.close();
+    std::remove("test-graph.graph");
+    EXPECT_EQ(header, "3 2 1");
+    EXPECT_TRUE(Edges == (gSparse::EdgeMatrix(2, 2) << 0, 1, 1, 2).finished());
+    EXPECT_TRUE(Weight == (gSparse::PrecisionRowMatrix(2, 1) << 2.0, 3.0).finished());
+}
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,174 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <gtest/gtest.h>
+#include <gSparse/GraphCSVStreamReader.hpp>
+#include <gSparse/GraphBinaryStreamReader.hpp>
+#include <gSparse/GraphCSVWriter.hpp>
+#include <gSparse/GraphBinaryWriter.hpp>
+#include <gSparse/Util/LineReader.hpp>
+#include <gSparse/Builder/CompleteGraph.hpp>
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <memory>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdio>
+#include <cstdint>
+
+/*******************************************************
+ * Helpers
+ * ******************************************************/
+static void writeText(const std::string & path, const std::string & text)
+{
+    std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+    file << text;
+}
+// Stream a whole graph and check batch sizes, then compare with the graph and its degrees
+static void expectStream(gSparse::IGraphStreamReader & reader, const gSparse::Graph & graph, std::size_t batchSize)
+{
+    reader.SetBatchSize(batchSize);
+    const std::size_t m = graph->GetEdgeCount();
+    gSparse::EdgeMatrix Edges(m, 2);
+    gSparse::PrecisionRowMatrix Weight(m, 1);
+    gSparse::PrecisionVector degree = gSparse::PrecisionVector::Zero(graph->GetNodeCount());
+    std::size_t read = 0;
+    std::size_t batches = 0;
+    std::size_t count = reader.ForEachBatch([&](const gSparse::EdgeMatrix & e, const gSparse::PrecisionRowMatrix & w)
+    {
+        ASSERT_LE(static_cast<std::size_t>(e.rows()), batchSize);
+        ASSERT_EQ(e.rows(), w.rows());
+        ASSERT_LE(read + e.rows(), m);
+        Edges.middleRows(read, e.rows()) = e;
+        Weight.middleRows(read, w.rows()) = w;
+        for (Eigen::Index i = 0; i != e.rows(); ++i)
+        {
+            degree(e(i, 0)) += w(i);
+            degree(e(i, 1)) += w(i);
+        }
+        read += e.rows();
+        ++batches;
+    });
+    EXPECT_EQ(count, m);
+    EXPECT_EQ(batches, (m + batchSize - 1) / batchSize);
+    EXPECT_TRUE(Edges == graph->GetEdgeList());
+    EXPECT_TRUE(Weight == graph->GetWeightList());
+    EXPECT_LT((degree - gSparse::PrecisionMatrix(graph->GetDegreeMatrix()).diagonal()).norm(), 1e-9);
+}
+
+/*******************************************************
+ * Test Cases
+ * ******************************************************/
+TEST(GraphStreamReader, CSV)
+{
+    gSparse::Graph graph = gSparse::Builder::buildRandomCompleteGraph(30, 0.5, 2.0, 5);
+    gSparse::GraphCSVWriter("stream-edges.csv", "stream-weight.csv").Write(graph);
+    gSparse::GraphCSVStreamReader reader("stream-edges.csv", "stream-weight.csv");
+    expectStream(reader, graph, 1);
+    expectStream(reader, graph, 100);
+    expectStream(reader, graph, 435);
+    expectStream(reader, graph, 1000);
+
+    // Unit weights
+    gSparse::GraphCSVStreamReader unweighted("stream-edges.csv");
+    gSparse::EdgeMatrix Edges;
+    gSparse::PrecisionRowMatrix Weight;
+    ASSERT_TRUE(unweighted.ReadBatch(Edges, Weight));
+    EXPECT_TRUE(Weight == gSparse::PrecisionRowMatrix::Ones(435, 1));
+    EXPECT_FALSE(unweighted.ReadBatch(Edges, Weight));
+    EXPECT_EQ(Edges.rows(), 0);
+    std::remove("stream-edges.csv");
+    std::remove("stream-weight.csv");
+}
+TEST(GraphStreamReader, CSVMalformed)
+{
+    gSparse::EdgeMatrix Edges;
+    gSparse::PrecisionRowMatrix Weight;
+    EXPECT_THROW(gSparse::GraphCSVStreamReader("ThisFileDoesNotExist.csv"), std::runtime_error);
+    EXPECT_THROW(gSparse::GraphCSVStreamReader("test-edges.csv", "ThisFileDoesNotExist.csv"), std::runtime_error);
+
+    writeText("stream-edges.csv", "0,1\n\n1,2\r\n2,x\n");
+    gSparse::GraphCSVStreamReader malformed("stream-edges.csv");
+    malformed.SetBatchSize(2);
+    ASSERT_TRUE(malformed.ReadBatch(Edges, Weight));
+    EXPECT_TRUE(Edges == (gSparse::EdgeMatrix(2, 2) << 0, 1, 1, 2).finished());
+    EXPECT_THROW(malformed.ReadBatch(Edges, Weight), std::runtime_error);
+
+    writeText("stream-edges.csv", "0,1\n1,2\n");
+    writeText("stream-weight.csv", "1\n");
+    EXPECT_THROW(gSparse::GraphCSVStreamReader("stream-edges.csv", "stream-weight.csv").ReadBatch(Edges, Weight), std::runtime_error);
+    writeText("stream-weight.csv", "1\n2\n3\n");
+    EXPECT_THROW(gSparse::GraphCSVStreamReader("stream-edges.csv", "stream-weight.csv").ReadBatch(Edges, Weight), std::runtime_error);
+    std::remove("stream-edges.csv");
+    std::remove("stream-weight.csv");
+}
+TEST(GraphStreamReader, Binary)
+{
+    gSparse::Graph graph = gSparse::Builder::buildRandomCompleteGraph(30, 0.5, 2.0, 9);
+    gSparse::GraphBinaryWriter("stream-graph.bin", true).Write(graph);
+    gSparse::GraphBinaryStreamReader reader("stream-graph.bin");
+    EXPECT_EQ(reader.GetNodeCount(), 30u);
+    EXPECT_EQ(reader.GetEdgeCount(), 435u);
+    expectStream(reader, graph, 1);
+    expectStream(reader, graph, 64);
+    expectStream(reader, graph, 435);
+    std::remove("stream-graph.bin");
+
+    // A file written with 64-bit node indices and float weights
+    gSparse::Util::BinaryGraphHeader header = gSparse::Util::BinaryGraphHeader::create(8, 4, 4);
+    header.nodeCount = 4;
+    header.edgeCount = 3;
+    const std::uint64_t edges[] = { 0, 1, 1, 2, 2, 3 };
+    const float weights[] = { 0.5f, 1.5f, 2.5f };
+    {
+        std::ofstream file("stream-graph.bin", std::ios::binary);
+        std::string bytes(static_cast<std::size_t>(header.fileSize()), '\0');
+        std::memcpy(&bytes[0], &header, sizeof(header));
+        std::memcpy(&bytes[header.edgeOffset()], edges, sizeof(edges));
+        std::memcpy(&bytes[header.weightOffset()], weights, sizeof(weights));
+        file << bytes;
+    }
+    gSparse::GraphBinaryStreamReader converted("stream-graph.bin");
+    converted.SetBatchSize(2);
+    gSparse::EdgeMatrix Edges;
+    gSparse::PrecisionRowMatrix Weight;
+    ASSERT_TRUE(converted.ReadBatch(Edges, Weight));
+    EXPECT_TRUE(Edges == (gSparse::EdgeMatrix(2, 2) << 0, 1, 1, 2).finished());
+    EXPECT_TRUE(Weight == (gSparse::PrecisionRowMatrix(2, 1) << 0.5, 1.5).finished());
+    ASSERT_TRUE(converted.ReadBatch(Edges, Weight));
+    EXPECT_TRUE(Edges == (gSparse::EdgeMatrix(1, 2) << 2, 3).finished());
+    EXPECT_TRUE(Weight == (gSparse::PrecisionRowMatrix(1, 1) << 2.5).finished());
+    EXPECT_FALSE(converted.ReadBatch(Edges, Weight));
+    std::remove("stream-graph.bin");
+
+    EXPECT_THROW(gSparse::GraphBinaryStreamReader("ThisFileDoesNotExist.bin"), std::runtime_error);
+    EXPECT_THROW(gSparse::GraphBinaryStreamReader("test-edges.csv"), std::runtime_error);
+}
+TEST(GraphStreamReader, LineReader)
+{
+    // Blocks smaller than a line
+    writeText("stream-lines.txt", "first line\n\nthe longest line of the file\nlast");
+    gSparse::Util::LineReader reader("stream-lines.txt", 4);
+    ASSERT_TRUE(reader.is_open());
+    for (int pass = 0; pass != 2; ++pass)
+    {
+        std::vector<std::string> lines;
+        const char * begin;
+        const char * end;
+        while (reader.next(begin, end)) lines.push_back(std::string(begin, end));
+        ASSERT_EQ(lines.size(), 4u);
+        EXPECT_EQ(lines[0], "first line");
+        EXPECT_EQ(lines[1], "");
+        EXPECT_EQ(lines[2], "the longest line of the file");
+        EXPECT_EQ(lines[3], "last");
+        reader.rewind();
+    }
+    std::remove("stream-lines.txt");
+}
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,197 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <gtest/gtest.h>
+#include <gSparse/UndirectedGraph.hpp>
+#include <gSparse/Preconditioner/IncompleteCholesky.hpp>
+#include <gSparse/Preconditioner/SpanningTree.hpp>
+#include <gSparse/Preconditioner/AggregationAMG.hpp>
+#include <gSparse/Preconditioner/ApproximateCholesky.hpp>
+
+#include <Eigen/IterativeLinearSolvers>
+
+#include <cmath>
+#include <limits>
+
+/*******************************************************
+ * Set up and utility functions
+ * ******************************************************/
+
+// Rounding error of the working precision, and the CG tolerance it can reach: about 1e-8 for double and 3e-4 for float
+static const gSparse::PRECISION epsilon = std::numeric_limits<gSparse::PRECISION>::epsilon();
+static const gSparse::PRECISION tolerance = std::sqrt(epsilon);
+
+// A grid graph has a high diameter. Skewed weights make Jacobi preconditioning converge slowly.
+gSparse::Graph buildSkewedGrid(std::size_t side)
+{
+    std::size_t n = side * side;
+    gSparse::EdgeMatrix Edges(2 * side * (side - 1), 2);
+    gSparse::PrecisionRowMatrix Weights(2 * side * (side - 1), 1);
+    std::size_t row = 0;
+    for (std::size_t i = 0; i != side; ++i)
+    {
+        for (std::size_t j = 0; j != side; ++j)
+        {
+            std::size_t node = i * side + j;
+            if (j + 1 != side)
+            {
+                Edges(row, 0) = node; Edges(row, 1) = node + 1;
+                Weights(row, 0) = 1000.0;
+                ++row;
+            }
+            if (i + 1 != side)
+            {
+                Edges(row, 0) = node; Edges(row, 1) = node + side;
+                Weights(row, 0) = 1.0 + static_cast<double>((node * 7) % 5);
+                ++row;
+            }
+        }
+    }
+    EXPECT_EQ(n, side * side);
+    return std::make_shared<gSparse::UndirectedGraph>(Edges, Weights);
+}
+
+// Solve L x = b for b = e_0 - e_{n-1} and return the number of CG iterations
+template <typename Preconditioner>
+Eigen::Index countIterations(const gSparse::Graph & graph, gSparse::PRECISION & residual)
+{
+    gSparse::PrecisionVector b = gSparse::PrecisionVector::Zero(graph->GetNodeCount());
+    b(0) = 1.0;
+    b(graph->GetNodeCount() - 1) = -1.0;
+    Eigen::ConjugateGradient<gSparse::SparsePrecisionMatrix, Eigen::Lower | Eigen::Upper, Preconditioner> cg;
+    cg.setMaxIterations(2000);
+    cg.setTolerance(tolerance);
+    cg.compute(graph->GetLaplacianMatrix());
+    EXPECT_EQ(Eigen::Success, cg.preconditioner().info());
+    gSparse::PrecisionVector x = cg.solve(b);
+    EXPECT_EQ(Eigen::Success, cg.info());
+    residual = (graph->GetLaplacianMatrix() * x - b).norm();
+    return cg.iterations();
+}
+
+/*******************************************************
+ * Test Suite
+ * ******************************************************/
+
+TEST(Preconditioner, IncompleteCholesky)
+{
+    auto graph = buildSkewedGrid(20);
+    gSparse::PRECISION jacobiResidual, residual;
+    Eigen::Index jacobi = countIterations<Eigen::DiagonalPreconditioner<gSparse::PRECISION>>(graph, jacobiResidual);
+    Eigen::Index iterations = countIterations<gSparse::Preconditioner::IncompleteCholesky>(graph, residual);
+    EXPECT_LT(residual, 1000 * tolerance);
+#ifdef GSPARSE_TEST_DOUBLE_PRECISION
+    // In float, rounding in the incomplete factor outweighs its gain over Jacobi on this grid
+    EXPECT_LT(iterations, jacobi);
+#endif
+}
+
+TEST(Preconditioner, SpanningTree)
+{
+    auto graph = buildSkewedGrid(20);
+    gSparse::PRECISION jacobiResidual, residual;
+    Eigen::Index jacobi = countIterations<Eigen::DiagonalPreconditioner<gSparse::PRECISION>>(graph, jacobiResidual);
+    Eigen::Index iterations = countIterations<gSparse::Preconditioner::SpanningTree>(graph, residual);
+    EXPECT_LT(residual, 1000 * tolerance);
+    EXPECT_LT(iterations, jacobi);
+}
+
+TEST(Preconditioner, SpanningTreeOfTree)
+{
+    // The preconditioner of a tree is the tree itself. CG converges in a single iteration.
+    gSparse::EdgeMatrix Edges(4, 2);
+    gSparse::PrecisionRowMatrix Weights(4, 1);
+    Edges << 0, 1, 1, 2, 1, 3, 3, 4;
+    Weights << 1, 2, 3, 4;
+    gSparse::Graph graph = std::make_shared<gSparse::UndirectedGraph>(Edges, Weights);
+    gSparse::PRECISION residual;
+    EXPECT_LE(countIterations<gSparse::Preconditioner::SpanningTree>(graph, residual), 1);
+    EXPECT_LT(residual, 1000 * epsilon);
+}
+
+TEST(Preconditioner, AggregationAMG)
+{
+    auto graph = buildSkewedGrid(20);
+    gSparse::PRECISION jacobiResidual, residual;
+    Eigen::Index jacobi = countIterations<Eigen::DiagonalPreconditioner<gSparse::PRECISION>>(graph, jacobiResidual);
+    Eigen::Index iterations = countIterations<gSparse::Preconditioner::AggregationAMG>(graph, residual);
+    EXPECT_LT(residual, 1000 * tolerance);
+    EXPECT_LT(iterations, jacobi);
+
+    gSparse::Preconditioner::AggregationAMG amg(graph->GetLaplacianMatrix());
+    EXPECT_GT(amg.GetLevelCount(), 1);
+}
+
+TEST(Preconditioner, ApproximateCholesky)
+{
+    auto graph = buildSkewedGrid(20);
+    gSparse::PRECISION jacobiResidual, residual;
+    Eigen::Index jacobi = countIterations<Eigen::DiagonalPreconditioner<gSparse::PRECISION>>(graph, jacobiResidual);
+    Eigen::Index iterations = countIterations<gSparse::Preconditioner::ApproximateCholesky>(graph, residual);
+    EXPECT_LT(residual, 1000 * tolerance);
+    EXPECT_LT(iterations, jacobi);
+
+    // The factor stays about as sparse as the graph
+    gSparse::Preconditioner::ApproximateCholesky chol(graph->GetLaplacianMatrix());
+    EXPECT_LT(chol.GetFactorSize(), 4 * graph->GetEdgeCount());
+}
+
+TEST(Preconditioner, ApproximateCholeskySeed)
+{
+    auto graph = buildSkewedGrid(10);
+    gSparse::PrecisionVector b = gSparse::PrecisionVector::Zero(graph->GetNodeCount());
+    b(0) = 1.0;
+    b(graph->GetNodeCount() - 1) = -1.0;
+
+    // Default seeds follow the global seed sequence
+    gSparse::Util::setGlobalSeed(3);
+    gSparse::Preconditioner::ApproximateCholesky first, second;
+    gSparse::Util::setGlobalSeed(3);
+    gSparse::Preconditioner::ApproximateCholesky replay;
+    EXPECT_NE(first.GetSeed(), second.GetSeed());
+    EXPECT_EQ(first.GetSeed(), replay.GetSeed());
+
+    // The same seed yields the same factorization, a different seed samples a different one
+    first.compute(graph->GetLaplacianMatrix());
+    replay.compute(graph->GetLaplacianMatrix());
+    second.compute(graph->GetLaplacianMatrix());
+    EXPECT_TRUE(first.solve(b) == replay.solve(b));
+    EXPECT_FALSE(first.solve(b) == second.solve(b));
+}
+
+TEST(Preconditioner, ApproximateCholeskyOfTree)
+{
+    // Eliminating a leaf of a tree creates no fill, so the factorization is exact
+    gSparse::EdgeMatrix Edges(4, 2);
+    gSparse::PrecisionRowMatrix Weights(4, 1);
+    Edges << 0, 1, 1, 2, 1, 3, 3, 4;
+    Weights << 1, 2, 3, 4;
+    gSparse::Graph graph = std::make_shared<gSparse::UndirectedGraph>(Edges, Weights);
+    gSparse::PRECISION residual;
+    EXPECT_LE(countIterations<gSparse::Preconditioner::ApproximateCholesky>(graph, residual), 1);
+    EXPECT_LT(residual, 1000 * epsilon);
+}
+
+TEST(Preconditioner, Disconnected)
+{
+    // Two separate paths, {0, 5, 1} and {2, 3, 4}. Every preconditioner must ground each component.
+    gSparse::EdgeMatrix Edges(4, 2);
+    Edges << 0, 5, 5, 1, 2, 3, 3, 4;
+    gSparse::Graph graph = std::make_shared<gSparse::UndirectedGraph>(Edges);
+    gSparse::PRECISION residual;
+    countIterations<gSparse::Preconditioner::IncompleteCholesky>(graph, residual);
+    EXPECT_LT(residual, 100 * tolerance);
+    countIterations<gSparse::Preconditioner::SpanningTree>(graph, residual);
+    EXPECT_LT(residual, 100 * tolerance);
+    countIterations<gSparse::Preconditioner::AggregationAMG>(graph, residual);
+    EXPECT_LT(residual, 100 * tolerance);
+    countIterations<gSparse::Preconditioner::ApproximateCholesky>(graph, residual);
+    EXPECT_LT(residual, 100 * tolerance);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
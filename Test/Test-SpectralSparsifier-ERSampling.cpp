@@ -5,6 +5,8 @@
 #include <gtest/gtest.h>
 #include <gSparse/UndirectedGraph.hpp>
 #include <gSparse/SpectralSparsifier/ERSampling.hpp>
+#include <gSparse/CompleteGraph.hpp>
+#include <gSparse/Builder/CompleteGraph.hpp>
 
 #include <iostream>
 TEST(ERSampling,ApproximateER)
@@ -42,6 +44,25 @@ TEST(ERSampling,ExactER)
 
 }
 
+TEST(ERSampling,ApproximateERCholesky)
+{
+    // Call constructors
+    gSparse::EdgeMatrix Edges(3, 2);
+	gSparse::PrecisionMatrix Weights(3, 1);
+	Edges(0, 0) = 0; Edges(0, 1) = 1;
+	Edges(1, 0) = 1; Edges(1, 1) = 2;
+	Edges(2, 0) = 2; Edges(2, 1) = 3;
+	Weights << 1, 2, 3;
+
+    // Call constructors
+    gSparse::Graph test(new gSparse::UndirectedGraph(Edges, Weights));
+    gSparse::SpectralSparsifier::ERSampling sparsifier(test);
+    sparsifier.SetERPolicy(gSparse::SpectralSparsifier::ER_METHODS::APPROXIMATE_ER_CHOLESKY);
+    EXPECT_EQ(gSparse::SpectralSparsifier::APPROXIMATE_ER_CHOLESKY, sparsifier.GetERPolicy());
+    EXPECT_NO_THROW(sparsifier.Compute());
+    EXPECT_NO_THROW(sparsifier.GetSparsifiedGraph());
+}
+
 TEST(ERSampling,Getters)
 {
     // Call constructors
@@ -86,6 +107,156 @@ TEST(ERSampling,Setters)
 
 }
 
+TEST(ERSampling,SparsifiedEdgesKeepOrder)
+{
+    auto test = gSparse::Builder::buildUnitCompleteGraph(30);
+    gSparse::SpectralSparsifier::ERSampling sparsifier(test, 4.0, 0.5, gSparse::SpectralSparsifier::EXACT_ER);
+    sparsifier.Compute();
+    auto sparse = sparsifier.GetSparsifiedGraph();
+    EXPECT_GT(sparse->GetEdgeCount(), 0);
+    EXPECT_LE(sparse->GetEdgeCount(), test->GetEdgeCount());
+
+    // Result edges are a subsequence of the original edge list, each listed once
+    std::size_t original = 0;
+    for (std::size_t i = 0; i != sparse->GetEdgeCount(); ++i)
+    {
+        while (original != test->GetEdgeCount() &&
+              (test->GetEdgeList()(original, 0) != sparse->GetEdgeList()(i, 0) ||
+               test->GetEdgeList()(original, 1) != sparse->GetEdgeList()(i, 1)))
+            ++original;
+        ASSERT_LT(original, test->GetEdgeCount());
+        EXPECT_GT(sparse->GetWeightList()(i), 0.0);
+        ++original;
+    }
+}
+
+TEST(ERSampling,IndependentSampling)
+{
+    auto test = gSparse::Builder::buildUnitCompleteGraph(60);
+    gSparse::SpectralSparsifier::ERSampling sparsifier(test, 0.5, 0.5, gSparse::SpectralSparsifier::EXACT_ER);
+    EXPECT_EQ(gSparse::SpectralSparsifier::SAMPLING_WITH_REPLACEMENT, sparsifier.GetSamplingMethod());
+    sparsifier.SetSamplingMethod(gSparse::SpectralSparsifier::INDEPENDENT_SAMPLING);
+    EXPECT_EQ(gSparse::SpectralSparsifier::INDEPENDENT_SAMPLING, sparsifier.GetSamplingMethod());
+    sparsifier.SetSeed(7);
+    EXPECT_EQ(7, sparsifier.GetSeed());
+    sparsifier.Compute();
+
+    // Each edge has p = 0.5 * (2/60) * log(60) / 0.25, about 0.27, and is reweighted by 1/p
+    sparsifier.SetThreadCount(1);
+    auto serial = sparsifier.GetSparsifiedGraph();
+    EXPECT_GT(serial->GetEdgeCount(), 0);
+    EXPECT_LT(serial->GetEdgeCount(), test->GetEdgeCount());
+    EXPECT_NEAR(test->GetWeightList().sum(), serial->GetWeightList().sum(), 0.2 * test->GetWeightList().sum());
+
+    // The result depends on the seed only, not on the thread count
+    sparsifier.SetThreadCount(3);
+    auto parallel = sparsifier.GetSparsifiedGraph();
+    ASSERT_EQ(serial->GetEdgeCount(), parallel->GetEdgeCount());
+    EXPECT_TRUE(serial->GetEdgeList() == parallel->GetEdgeList());
+    EXPECT_TRUE(serial->GetWeightList() == parallel->GetWeightList());
+
+    sparsifier.SetSeed(8);
+    auto other = sparsifier.GetSparsifiedGraph();
+    EXPECT_FALSE(other->GetEdgeCount() == serial->GetEdgeCount() && other->GetEdgeList() == serial->GetEdgeList());
+}
+
+TEST(ERSampling,KeepsNodeCount)
+{
+    // Both methods keep a handful of edges: about 7 draws, or p about 0.014 per edge.
+    // Most nodes lose every edge but stay in the sparsifier.
+    auto test = gSparse::Builder::buildUnitCompleteGraph(30);
+    for (auto method : { gSparse::SpectralSparsifier::SAMPLING_WITH_REPLACEMENT, gSparse::SpectralSparsifier::INDEPENDENT_SAMPLING })
+    {
+        gSparse::SpectralSparsifier::ERSampling sparsifier(test, 1.0, 4.0, gSparse::SpectralSparsifier::EXACT_ER);
+        sparsifier.SetSamplingMethod(method);
+        sparsifier.SetSeed(3);
+        sparsifier.Compute();
+        auto sparse = sparsifier.GetSparsifiedGraph();
+        EXPECT_GT(sparse->GetEdgeCount(), 0);
+        EXPECT_LT(sparse->GetEdgeCount(), 30);
+        EXPECT_EQ(test->GetNodeCount(), sparse->GetNodeCount());
+        EXPECT_EQ(test->GetNodeCount(), sparse->GetLaplacianMatrix().rows());
+    }
+}
+
+TEST(ERSampling,IndependentSamplingKeepsNoEdge)
+{
+    auto test = gSparse::Builder::buildUnitCompleteGraph(30);
+    gSparse::SpectralSparsifier::ERSampling sparsifier(test, 4.0, 0.5, gSparse::SpectralSparsifier::EXACT_ER);
+    sparsifier.SetSamplingMethod(gSparse::SpectralSparsifier::INDEPENDENT_SAMPLING);
+    sparsifier.SetC(1e-9);
+    sparsifier.SetEpsilon(1.0);
+    sparsifier.Compute();
+    EXPECT_THROW(sparsifier.GetSparsifiedGraph(), std::runtime_error);
+}
+
+TEST(ERSampling,ZeroSamplingProbability)
+{
+    // Zero weights give every edge a zero sampling probability, so there is nothing to draw from
+    gSparse::EdgeMatrix Edges(3, 2);
+    Edges << 0, 1, 1, 2, 2, 3;
+    auto test = std::make_shared<gSparse::UndirectedGraph>(Edges, gSparse::PrecisionRowMatrix::Zero(3, 1));
+    gSparse::SpectralSparsifier::ERSampling sparsifier(test, 4.0, 0.5, gSparse::SpectralSparsifier::EXACT_ER);
+    sparsifier.Compute();
+    EXPECT_THROW(sparsifier.GetSparsifiedGraph(), std::runtime_error);
+}
+
+TEST(ERSampling,ImplicitCompleteGraph)
+{
+    // Edges and weights of an implicit complete graph are computed, so it is never materialized
+    auto test = gSparse::Builder::buildImplicitCompleteGraph(200, 2.0);
+    const gSparse::CompleteGraph & complete = static_cast<const gSparse::CompleteGraph &>(*test);
+    for (auto method : { gSparse::SpectralSparsifier::SAMPLING_WITH_REPLACEMENT, gSparse::SpectralSparsifier::INDEPENDENT_SAMPLING })
+    {
+        gSparse::SpectralSparsifier::ERSampling sparsifier(test, 0.5, 0.5);
+        sparsifier.SetSamplingMethod(method);
+        sparsifier.SetSeed(5);
+        sparsifier.Compute();
+        auto sparse = sparsifier.GetSparsifiedGraph();
+        EXPECT_FALSE(complete.IsMaterialized());
+        EXPECT_EQ(200, sparse->GetNodeCount());
+        ASSERT_GT(sparse->GetEdgeCount(), 0);
+        EXPECT_LT(sparse->GetEdgeCount(), test->GetEdgeCount());
+
+        // Edges keep the order of the complete graph and are reweighted from weight 2
+        std::size_t previous = 0;
+        for (std::size_t i = 0; i != sparse->GetEdgeCount(); ++i)
+        {
+            std::size_t index = complete.EdgeIndex(sparse->GetEdgeList()(i, 0), sparse->GetEdgeList()(i, 1));
+            EXPECT_TRUE(i == 0 || index > previous);
+            previous = index;
+            EXPECT_GE(sparse->GetWeightList()(i), 2.0);
+        }
+    }
+    EXPECT_FALSE(complete.IsMaterialized());
+}
+
+TEST(ERSampling,Reproducible)
+{
+    // The same seed yields the same sparsifier, including the approximate effective resistance
+    auto test = gSparse::Builder::buildRandomCompleteGraph(40, 1.0, 5.0, 1);
+    for (auto method : { gSparse::SpectralSparsifier::SAMPLING_WITH_REPLACEMENT, gSparse::SpectralSparsifier::INDEPENDENT_SAMPLING })
+    {
+        gSparse::SpectralSparsifier::ERSampling first(test, 0.5, 0.5);
+        first.SetSamplingMethod(method);
+        first.SetSeed(2);
+        first.Compute();
+        auto a = first.GetSparsifiedGraph();
+
+        gSparse::SpectralSparsifier::ERSampling second(test, 0.5, 0.5);
+        second.SetSamplingMethod(method);
+        second.SetSeed(2);
+        second.SetThreadCount(3);
+        second.Compute();
+        auto b = second.GetSparsifiedGraph();
+
+        EXPECT_TRUE(first.GetEffectiveResistance() == second.GetEffectiveResistance());
+        ASSERT_EQ(a->GetEdgeCount(), b->GetEdgeCount());
+        EXPECT_TRUE(a->GetEdgeList() == b->GetEdgeList());
+        EXPECT_TRUE(a->GetWeightList() == b->GetWeightList());
+    }
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
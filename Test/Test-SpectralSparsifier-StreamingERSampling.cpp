@@ -0,0 +1,146 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <gtest/gtest.h>
+#include <gSparse/UndirectedGraph.hpp>
+#include <gSparse/SpectralSparsifier/StreamingERSampling.hpp>
+#include <gSparse/GraphBinaryWriter.hpp>
+#include <gSparse/GraphBinaryStreamReader.hpp>
+#include <gSparse/Builder/CompleteGraph.hpp>
+#include <Eigen/Dense>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <memory>
+
+// Largest relative error of x^T L_H x against x^T L_G x over random vectors
+static double quadraticFormError(const gSparse::Graph & graph, const gSparse::Graph & sparsifier)
+{
+    const Eigen::Index n = static_cast<Eigen::Index>(graph->GetNodeCount());
+    gSparse::PrecisionMatrix LG(graph->GetLaplacianMatrix());
+    gSparse::PrecisionMatrix LH(sparsifier->GetLaplacianMatrix());
+    std::srand(1);
+    double error = 0.0;
+    for (int k = 0; k != 20; ++k)
+    {
+        gSparse::PrecisionVector x = gSparse::PrecisionVector::Random(n);
+        double expected = x.dot(LG * x);
+        error = std::max(error, std::abs(x.dot(LH * x) - expected) / expected);
+    }
+    return error;
+}
+
+TEST(StreamingERSampling, MergeAndReduce)
+{
+    gSparse::Graph graph = gSparse::Builder::buildRandomCompleteGraph(80, 1.0, 2.0, 4);
+    gSparse::GraphBinaryWriter("streaming-graph.bin").Write(graph);
+    std::shared_ptr<gSparse::GraphBinaryStreamReader> reader = std::make_shared<gSparse::GraphBinaryStreamReader>("streaming-graph.bin");
+    reader->SetBatchSize(200);
+
+    gSparse::SpectralSparsifier::StreamingERSampling sparsifier(reader, 0.5, 0.5, gSparse::SpectralSparsifier::EXACT_ER);
+    EXPECT_THROW(sparsifier.GetSparsifiedGraph(), std::logic_error);
+    sparsifier.SetReduceThreshold(1000);
+    sparsifier.SetSeed(3);
+    EXPECT_EQ(sparsifier.GetReduceThreshold(), 1000u);
+    EXPECT_EQ(sparsifier.Compute(), gSparse::SUCCESSFUL);
+    EXPECT_EQ(sparsifier.GetInfo(), gSparse::SUCCESSFUL);
+
+    // The buffer never holds more than the threshold plus one batch
+    EXPECT_GT(sparsifier.GetReduceCount(), 2u);
+    EXPECT_LE(sparsifier.GetPeakEdgeCount(), 1200u);
+    gSparse::Graph sparse = sparsifier.GetSparsifiedGraph();
+    EXPECT_GT(sparse->GetEdgeCount(), 0u);
+    EXPECT_LT(sparse->GetEdgeCount(), 1000u);
+    EXPECT_EQ(sparse->GetNodeCount(), graph->GetNodeCount());
+    EXPECT_NEAR(sparse->GetWeightList().sum(), graph->GetWeightList().sum(), 0.2 * graph->GetWeightList().sum());
+    EXPECT_LT(quadraticFormError(graph, sparse), 0.5);
+
+    // The same seed yields the same sparsifier
+    gSparse::SpectralSparsifier::StreamingERSampling again(reader, 0.5, 0.5, gSparse::SpectralSparsifier::EXACT_ER);
+    again.SetReduceThreshold(1000);
+    again.SetSeed(3);
+    again.Compute();
+    gSparse::Graph other = again.GetSparsifiedGraph();
+    ASSERT_EQ(other->GetEdgeCount(), sparse->GetEdgeCount());
+    EXPECT_TRUE(other->GetEdgeList() == sparse->GetEdgeList());
+    EXPECT_TRUE(other->GetWeightList() == sparse->GetWeightList());
+    std::remove("streaming-graph.bin");
+}
+TEST(StreamingERSampling, SingleReduce)
+{
+    // The automatic threshold 2 * C * n log n / eps^2, about 2000, exceeds the 1770 edges of the graph,
+    // so it is sparsified once, at the end of the stream
+    gSparse::Graph graph = gSparse::Builder::buildUnitCompleteGraph(60);
+    gSparse::GraphBinaryWriter("streaming-graph.bin").Write(graph);
+    std::shared_ptr<gSparse::GraphBinaryStreamReader> reader = std::make_shared<gSparse::GraphBinaryStreamReader>("streaming-graph.bin");
+    reader->SetBatchSize(100);
+    gSparse::SpectralSparsifier::StreamingERSampling sparsifier(reader, 0.5, 0.35);
+    EXPECT_EQ(sparsifier.GetERPolicy(), gSparse::SpectralSparsifier::APPROXIMATE_ER);
+    EXPECT_EQ(sparsifier.GetReduceThreshold(), 0u);
+    EXPECT_EQ(sparsifier.Compute(), gSparse::SUCCESSFUL);
+    EXPECT_EQ(sparsifier.GetReduceCount(), 1u);
+    EXPECT_EQ(sparsifier.GetPeakEdgeCount(), graph->GetEdgeCount());
+    EXPECT_LT(sparsifier.GetSparsifiedGraph()->GetEdgeCount(), graph->GetEdgeCount());
+    std::remove("streaming-graph.bin");
+}
+TEST(StreamingERSampling, KeepsNodeCount)
+{
+    // Each edge is kept with p about 0.014, so most nodes lose every edge but stay in the sparsifier
+    gSparse::Graph graph = gSparse::Builder::buildUnitCompleteGraph(30);
+    gSparse::GraphBinaryWriter("streaming-graph.bin").Write(graph);
+    std::shared_ptr<gSparse::GraphBinaryStreamReader> reader = std::make_shared<gSparse::GraphBinaryStreamReader>("streaming-graph.bin");
+    gSparse::SpectralSparsifier::StreamingERSampling sparsifier(reader, 1.0, 4.0, gSparse::SpectralSparsifier::EXACT_ER);
+    sparsifier.SetSeed(3);
+    EXPECT_EQ(sparsifier.Compute(), gSparse::SUCCESSFUL);
+    gSparse::Graph sparse = sparsifier.GetSparsifiedGraph();
+    EXPECT_GT(sparse->GetEdgeCount(), 0u);
+    EXPECT_LT(sparse->GetEdgeCount(), 30u);
+    EXPECT_EQ(sparse->GetNodeCount(), graph->GetNodeCount());
+    EXPECT_EQ(sparse->GetLaplacianMatrix().rows(), 30);
+    std::remove("streaming-graph.bin");
+}
+TEST(StreamingERSampling, NoEdges)
+{
+    // An empty stream
+    gSparse::GraphBinaryWriter("streaming-graph.bin").Write(
+        std::make_shared<gSparse::UndirectedGraph>(gSparse::EdgeMatrix(0, 2), gSparse::PrecisionRowMatrix(0, 1), 0));
+    gSparse::SpectralSparsifier::StreamingERSampling empty(std::make_shared<gSparse::GraphBinaryStreamReader>("streaming-graph.bin"));
+    EXPECT_EQ(empty.Compute(), gSparse::SUCCESSFUL);
+    EXPECT_EQ(empty.GetReduceCount(), 0u);
+    EXPECT_THROW(empty.GetSparsifiedGraph(), std::runtime_error);
+
+    // The final resparsification keeps no edge
+    gSparse::GraphBinaryWriter("streaming-graph.bin").Write(gSparse::Builder::buildUnitCompleteGraph(30));
+    gSparse::SpectralSparsifier::StreamingERSampling sparsifier(std::make_shared<gSparse::GraphBinaryStreamReader>("streaming-graph.bin"),
+        1e-9, 1.0, gSparse::SpectralSparsifier::EXACT_ER);
+    EXPECT_EQ(sparsifier.Compute(), gSparse::SUCCESSFUL);
+    EXPECT_EQ(sparsifier.GetReduceCount(), 1u);
+    EXPECT_THROW(sparsifier.GetSparsifiedGraph(), std::runtime_error);
+    std::remove("streaming-graph.bin");
+}
+TEST(StreamingERSampling, Setters)
+{
+    EXPECT_THROW(gSparse::SpectralSparsifier::StreamingERSampling(gSparse::GraphStreamReader()), std::invalid_argument);
+    gSparse::GraphBinaryWriter("streaming-graph.bin").Write(gSparse::Builder::buildUnitCompleteGraph(5));
+    gSparse::SpectralSparsifier::StreamingERSampling sparsifier(std::make_shared<gSparse::GraphBinaryStreamReader>("streaming-graph.bin"));
+    std::remove("streaming-graph.bin");
+    EXPECT_EQ(sparsifier.GetInfo(), gSparse::NOT_COMPUTED);
+    EXPECT_DOUBLE_EQ(sparsifier.GetC(), 4.0);
+    EXPECT_NEAR(sparsifier.GetEpsilon(), 0.3, 1e-6);
+    sparsifier.SetC(2.0);
+    sparsifier.SetEpsilon(0.1);
+    sparsifier.SetERPolicy(gSparse::SpectralSparsifier::APPROXIMATE_ER_CHOLESKY);
+    sparsifier.SetSeed(11);
+    EXPECT_DOUBLE_EQ(sparsifier.GetC(), 2.0);
+    EXPECT_DOUBLE_EQ(sparsifier.GetEpsilon(), 0.1);
+    EXPECT_EQ(sparsifier.GetERPolicy(), gSparse::SpectralSparsifier::APPROXIMATE_ER_CHOLESKY);
+    EXPECT_EQ(sparsifier.GetSeed(), 11u);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -9,6 +9,8 @@
 #include <memory>
 #include <string>
 #include <fstream>
+#include <thread>
+#include <vector>
 
 /*******************************************************
  * Set up and utility functions
@@ -183,7 +185,7 @@ TEST(UndirectedGraph, AdjacencyMatrix)
 	Edges(2, 0) = 2; Edges(2, 1) = 3;
     Weights << 1, 2, 3;
 
-    Eigen::MatrixXd ValidateAdjacencyMatrix(4, 4);
+    gSparse::PrecisionMatrix ValidateAdjacencyMatrix(4, 4);
 	ValidateAdjacencyMatrix << 
         0, 1, 0, 0,
 	    1, 0, 2, 0,
@@ -265,6 +267,154 @@ TEST(UndirectedGraph, IncidenceMatrix)
 }
 
 
+TEST(UndirectedGraph, EdgeListLayout)
+{
+    // Both end points of an edge are adjacent in memory
+    gSparse::EdgeMatrix Edges(3, 2);
+    Edges << 0, 1, 1, 2, 2, 3;
+    gSparse::UndirectedGraph test(Edges);
+    const gSparse::NodeIndex * data = test.GetEdgeList().data();
+    EXPECT_EQ(1U, data[1]);
+    EXPECT_EQ(1U, data[2]);
+    EXPECT_EQ(3U, data[5]);
+}
+
+TEST(UndirectedGraph, MoveConstructors)
+{
+    gSparse::EdgeMatrix Edges(3, 2);
+    gSparse::PrecisionRowMatrix Weights(3, 1);
+    Edges << 0, 1, 1, 2, 2, 3;
+    Weights << 1, 2, 3;
+    const gSparse::NodeIndex * edgeBuffer = Edges.data();
+    const gSparse::PRECISION * weightBuffer = Weights.data();
+
+    // The graph takes over the buffers
+    gSparse::UndirectedGraph test(std::move(Edges), std::move(Weights));
+    EXPECT_EQ(edgeBuffer, test.GetEdgeList().data());
+    EXPECT_EQ(weightBuffer, test.GetWeightList().data());
+    EXPECT_EQ(4, test.GetNodeCount());
+    gSparse::PrecisionMatrix laplacian = gSparse::PrecisionMatrix(test.GetLaplacianMatrix());
+
+    // Moving a graph keeps its buffers and its matrices
+    gSparse::UndirectedGraph moved(std::move(test));
+    EXPECT_EQ(edgeBuffer, moved.GetEdgeList().data());
+    EXPECT_TRUE(moved.HasLaplacianMatrix());
+    EXPECT_EQ(laplacian, gSparse::PrecisionMatrix(moved.GetLaplacianMatrix()));
+    EXPECT_EQ(0, test.GetEdgeCount());
+    EXPECT_EQ(0, test.GetEdgeList().rows());
+
+    gSparse::EdgeMatrix OtherEdges(1, 2);
+    OtherEdges << 0, 1;
+    gSparse::UndirectedGraph other(OtherEdges);
+    other = std::move(moved);
+    EXPECT_EQ(edgeBuffer, other.GetEdgeList().data());
+    EXPECT_EQ(3, other.GetEdgeCount());
+    EXPECT_EQ(laplacian, gSparse::PrecisionMatrix(other.GetLaplacianMatrix()));
+}
+
+TEST(UndirectedGraph, NodeCount)
+{
+    // Nodes past the last endpoint are kept as isolated nodes
+    gSparse::EdgeMatrix Edges(2, 2);
+    gSparse::PrecisionRowMatrix Weights(2, 1);
+    Edges << 0, 1, 1, 2;
+    Weights << 1, 2;
+    gSparse::UndirectedGraph test(std::move(Edges), std::move(Weights), 5);
+    EXPECT_EQ(5, test.GetNodeCount());
+    EXPECT_EQ(2, test.GetEdgeCount());
+    EXPECT_EQ(5, test.GetLaplacianMatrix().rows());
+    EXPECT_EQ(0.0, test.GetDegreeMatrix().coeff(4, 4));
+
+    // A graph without edges
+    gSparse::UndirectedGraph empty(gSparse::EdgeMatrix(0, 2), gSparse::PrecisionRowMatrix(0, 1), 3);
+    EXPECT_EQ(3, empty.GetNodeCount());
+    EXPECT_EQ(0, empty.GetEdgeCount());
+    EXPECT_EQ(3, empty.GetLaplacianMatrix().rows());
+    EXPECT_EQ(0.0, gSparse::PrecisionMatrix(empty.GetLaplacianMatrix()).norm());
+
+    // Edges must not point past the node count
+    gSparse::EdgeMatrix Long(1, 2);
+    gSparse::PrecisionRowMatrix LongWeights(1, 1);
+    Long << 0, 4;
+    LongWeights << 1;
+    EXPECT_THROW(gSparse::UndirectedGraph(std::move(Long), std::move(LongWeights), 3), std::invalid_argument);
+}
+
+TEST(UndirectedGraph, WrapExternalMemory)
+{
+    std::vector<gSparse::NodeIndex> edges{ 0, 1, 1, 2, 2, 3 };
+    std::vector<gSparse::PRECISION> weights{ 1, 2, 3 };
+    gSparse::UndirectedGraph test(gSparse::EdgeList(edges.data(), 3, 2), gSparse::WeightList(weights.data(), 3, 1));
+    EXPECT_EQ(edges.data(), test.GetEdgeList().data());
+    EXPECT_EQ(weights.data(), test.GetWeightList().data());
+    EXPECT_EQ(4, test.GetNodeCount());
+    EXPECT_EQ(3, test.GetEdgeCount());
+
+    gSparse::EdgeMatrix Edges(3, 2);
+    gSparse::PrecisionRowMatrix Weights(3, 1);
+    Edges << 0, 1, 1, 2, 2, 3;
+    Weights << 1, 2, 3;
+    gSparse::UndirectedGraph validation(Edges, Weights);
+    EXPECT_EQ(gSparse::PrecisionMatrix(validation.GetLaplacianMatrix()), gSparse::PrecisionMatrix(test.GetLaplacianMatrix()));
+}
+
+TEST(UndirectedGraph, LazyMatrices)
+{
+    gSparse::EdgeMatrix Edges(3, 2);
+	gSparse::PrecisionMatrix Weights(3, 1);
+	Edges(0, 0) = 0; Edges(0, 1) = 1;
+	Edges(1, 0) = 1; Edges(1, 1) = 2;
+	Edges(2, 0) = 2; Edges(2, 1) = 3;
+    Weights << 1, 2, 3;
+
+    gSparse::UndirectedGraph test(Edges, Weights);
+    EXPECT_FALSE(test.HasLaplacianMatrix());
+
+    // Several threads asking at once get the same matrix
+    std::vector<const gSparse::SparsePrecisionMatrix *> laplacians(4);
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t != laplacians.size(); ++t)
+        workers.push_back(std::thread([&, t]() { laplacians[t] = &test.GetLaplacianMatrix(); }));
+    for (auto & worker : workers) worker.join();
+    for (auto laplacian : laplacians) EXPECT_EQ(laplacians[0], laplacian);
+    EXPECT_TRUE(test.HasLaplacianMatrix());
+
+    gSparse::PrecisionMatrix laplacian = gSparse::PrecisionMatrix(test.GetLaplacianMatrix());
+    test.ReleaseMatrices();
+    EXPECT_FALSE(test.HasLaplacianMatrix());
+    EXPECT_TRUE(laplacian.isApprox(gSparse::PrecisionMatrix(test.GetLaplacianMatrix())));
+    EXPECT_TRUE(laplacian.isApprox(gSparse::PrecisionMatrix(test.GetDegreeMatrix()) - gSparse::PrecisionMatrix(test.GetAdjacentMatrix())));
+}
+
+TEST(UndirectedGraph, LaplacianWithDuplicateEdges)
+{
+    // Edge 0-1 appears twice, in both directions. Node 4 has only a self-loop.
+    gSparse::EdgeMatrix Edges(6, 2);
+	gSparse::PrecisionMatrix Weights(6, 1);
+    Edges << 0, 1, 2, 1, 1, 0, 4, 4, 3, 0, 2, 3;
+    Weights << 1, 2, 3, 4, 5, 6;
+
+    gSparse::UndirectedGraph test(Edges, Weights);
+    gSparse::PrecisionMatrix expected = gSparse::PrecisionMatrix(test.GetDegreeMatrix()) - gSparse::PrecisionMatrix(test.GetAdjacentMatrix());
+    const gSparse::SparsePrecisionMatrix & laplacian = test.GetLaplacianMatrix();
+    EXPECT_TRUE(laplacian.isCompressed());
+    EXPECT_EQ(5 + 2 * 4, laplacian.nonZeros());
+    EXPECT_TRUE(expected.isApprox(gSparse::PrecisionMatrix(laplacian)));
+    EXPECT_DOUBLE_EQ(-4.0, laplacian.coeff(0, 1));
+    EXPECT_DOUBLE_EQ(0.0, laplacian.coeff(4, 4));
+
+    // Row indices are sorted within each column
+    for (Eigen::Index j = 0; j != laplacian.outerSize(); ++j)
+    {
+        Eigen::Index previous = -1;
+        for (gSparse::SparsePrecisionMatrix::InnerIterator it(laplacian, j); it; ++it)
+        {
+            EXPECT_LT(previous, it.row());
+            previous = it.row();
+        }
+    }
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -4,6 +4,7 @@
 
 #include <gtest/gtest.h>
 #include <gSparse/Util/JL.hpp>
+#include <gSparse/UndirectedGraph.hpp>
 
 
 TEST(JL,ZeroTol)
@@ -36,6 +37,52 @@ TEST(JL,Scale)
 
     EXPECT_EQ(Validate, mat);
 }
+TEST(JL,ImplicitEntry)
+{
+    // Entries are reproducible and take only the two JL values
+    for (std::size_t r = 0; r != 4; ++r)
+    {
+        for (std::size_t c = 0; c != 50; ++c)
+        {
+            gSparse::PRECISION x = gSparse::Util::implicitProjectionEntry(r, c, 4.0, 0.5, 42);
+            EXPECT_TRUE(x == 0.5 || x == -0.5);
+            EXPECT_EQ(x, gSparse::Util::implicitProjectionEntry(r, c, 4.0, 0.5, 42));
+        }
+    }
+    EXPECT_EQ(1.0, gSparse::Util::implicitProjectionEntry(3, 7, 1.0, 0.0, 42));
+    EXPECT_EQ(-1.0, gSparse::Util::implicitProjectionEntry(3, 7, 1.0, 1.0, 42));
+}
+TEST(JL,ImplicitProjection)
+{
+    gSparse::EdgeMatrix Edges(4, 2);
+	gSparse::PrecisionMatrix Weights(4, 1);
+	Edges(0, 0) = 0; Edges(0, 1) = 1;
+	Edges(1, 0) = 1; Edges(1, 1) = 2;
+	Edges(2, 0) = 2; Edges(2, 1) = 3;
+	Edges(3, 0) = 3; Edges(3, 1) = 0;
+	Weights << 1, 2, 3, 4;
+    gSparse::UndirectedGraph graph(Edges, Weights);
+
+    // Materialize the implicit projection and compare against the explicit product
+    const std::size_t rows = 5;
+    gSparse::PrecisionMatrix Q(rows, graph.GetEdgeCount());
+    for (std::size_t r = 0; r != rows; ++r)
+        for (std::size_t c = 0; c != graph.GetEdgeCount(); ++c)
+            Q(r, c) = gSparse::Util::implicitProjectionEntry(r, c, 5.0, 0.5, 7);
+    gSparse::PrecisionMatrix expected =
+        (Q * graph.GetWeightMatrix().cwiseSqrt() * graph.GetIncidentMatrix()).transpose();
+
+    gSparse::PrecisionMatrix Y = gSparse::Util::implicitProjection(graph.GetEdgeList(),
+        graph.GetWeightList(), graph.GetNodeCount(), rows, 5.0, 0.5, 7);
+    ASSERT_EQ(graph.GetNodeCount(), Y.rows());
+    ASSERT_EQ(rows, Y.cols());
+    EXPECT_LT((Y - expected).norm(), 1e-12);
+
+    // A different seed gives a different projection
+    gSparse::PrecisionMatrix Z = gSparse::Util::implicitProjection(graph.GetEdgeList(),
+        graph.GetWeightList(), graph.GetNodeCount(), rows, 5.0, 0.5, 8);
+    EXPECT_GT((Y - Z).norm(), 0.0);
+}
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,101 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <gtest/gtest.h>
+#include <gSparse/Builder/CompleteGraph.hpp>
+#include <gSparse/Util/LaplacianOperator.hpp>
+#include <gSparse/Preconditioner/ApproximateCholesky.hpp>
+
+#include <Eigen/IterativeLinearSolvers>
+
+#include <vector>
+#include <cmath>
+#include <limits>
+
+// Machine epsilon of gSparse::PRECISION, and a CG tolerance that is reachable in it
+static const gSparse::PRECISION epsilon = std::numeric_limits<gSparse::PRECISION>::epsilon();
+static const gSparse::PRECISION tolerance = std::sqrt(epsilon);
+
+TEST(LaplacianOperator, Product)
+{
+    // 400 nodes give 160000 non-zeros, enough for two threads
+    auto graph = gSparse::Builder::buildRandomCompleteGraph(400, 1.0, 5.0);
+    const gSparse::SparsePrecisionMatrix & L = graph->GetLaplacianMatrix();
+    gSparse::PrecisionVector x = gSparse::PrecisionVector::Random(400);
+    gSparse::PrecisionMatrix X = gSparse::PrecisionMatrix::Random(400, 5);
+    for (std::size_t threads : {1, 2, 3})
+    {
+        gSparse::Util::LaplacianOperator op(L, threads);
+        EXPECT_LE(op.GetThreadCount(), threads);
+        gSparse::PrecisionVector y = op * x;
+        EXPECT_LT((y - L * x).norm(), 100 * epsilon * (L * x).norm());
+        gSparse::PrecisionMatrix Y = op * X;
+        EXPECT_LT((Y - L * X).norm(), 100 * epsilon * (L * X).norm());
+    }
+    gSparse::Util::LaplacianOperator op(L, 2);
+    EXPECT_EQ(2, op.GetThreadCount());
+    // Copies share the worker threads
+    gSparse::Util::LaplacianOperator copy(op);
+    gSparse::PrecisionVector y = copy * x;
+    EXPECT_LT((y - L * x).norm(), 100 * epsilon * (L * x).norm());
+    op.SetThreadCount(1);
+    EXPECT_EQ(1, op.GetThreadCount());
+    y = op * x;
+    EXPECT_LT((y - L * x).norm(), 100 * epsilon * (L * x).norm());
+}
+
+TEST(LaplacianOperator, WorkerPool)
+{
+    gSparse::Util::WorkerPool single(1);
+    EXPECT_EQ(1, single.GetThreadCount());
+    gSparse::Util::WorkerPool pool(3);
+    EXPECT_EQ(3, pool.GetThreadCount());
+    // Every task runs each thread index exactly once, and the pool is reused across tasks
+    for (int task = 0; task != 100; ++task)
+    {
+        std::vector<int> hits(3, 0);
+        pool.Run([&](std::size_t t) { hits[t] += 1; });
+        EXPECT_EQ(std::vector<int>(3, 1), hits);
+    }
+}
+
+TEST(LaplacianOperator, SmallGraphUsesOneThread)
+{
+    auto graph = gSparse::Builder::buildUnitCompleteGraph(10);
+    gSparse::Util::LaplacianOperator op(graph->GetLaplacianMatrix(), 8);
+    EXPECT_EQ(1, op.GetThreadCount());
+}
+
+TEST(LaplacianOperator, ConjugateGradient)
+{
+    auto graph = gSparse::Builder::buildRandomCompleteGraph(400, 1.0, 5.0);
+    const gSparse::SparsePrecisionMatrix & L = graph->GetLaplacianMatrix();
+    gSparse::Util::LaplacianOperator op(L, 2);
+    gSparse::PrecisionVector b = gSparse::PrecisionVector::Zero(400);
+    b(0) = 1.0;
+    b(399) = -1.0;
+
+    Eigen::ConjugateGradient<gSparse::Util::LaplacianOperator, Eigen::Lower | Eigen::Upper,
+        Eigen::DiagonalPreconditioner<gSparse::PRECISION>> jacobi;
+    jacobi.setTolerance(tolerance);
+    jacobi.compute(op);
+    gSparse::PrecisionVector x = jacobi.solve(b);
+    EXPECT_EQ(Eigen::Success, jacobi.info());
+    EXPECT_LT((L * x - b).norm(), 10 * tolerance * b.norm());
+
+    // Preconditioners are computed from the operator's InnerIterator
+    Eigen::ConjugateGradient<gSparse::Util::LaplacianOperator, Eigen::Lower | Eigen::Upper,
+        gSparse::Preconditioner::ApproximateCholesky> chol;
+    chol.setTolerance(tolerance);
+    chol.compute(op);
+    x = chol.solve(b);
+    EXPECT_EQ(Eigen::Success, chol.info());
+    EXPECT_LT((L * x - b).norm(), 10 * tolerance * b.norm());
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
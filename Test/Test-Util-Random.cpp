@@ -0,0 +1,79 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <gtest/gtest.h>
+#include <gSparse/Util/Random.hpp>
+
+#include <vector>
+
+TEST(Random,PhiloxKnownAnswer)
+{
+    // Known answers of Philox4x32-10 from the Random123 distribution
+    std::uint32_t zero[4] = { 0, 0, 0, 0 };
+    gSparse::Util::philox4x32(zero, 0, 0);
+    EXPECT_EQ(0x6627e8d5U, zero[0]);
+    EXPECT_EQ(0xe169c58dU, zero[1]);
+    EXPECT_EQ(0xbc57ac4cU, zero[2]);
+    EXPECT_EQ(0x9b00dbd8U, zero[3]);
+
+    std::uint32_t pi[4] = { 0x243f6a88U, 0x85a308d3U, 0x13198a2eU, 0x03707344U };
+    gSparse::Util::philox4x32(pi, 0xa4093822U, 0x299f31d0U);
+    EXPECT_EQ(0xd16cfe09U, pi[0]);
+    EXPECT_EQ(0x94fdccebU, pi[1]);
+    EXPECT_EQ(0x5001e420U, pi[2]);
+    EXPECT_EQ(0x24126ea1U, pi[3]);
+}
+
+TEST(Random,StreamSeek)
+{
+    gSparse::Util::RandomStream stream(123, 4);
+    std::vector<std::uint64_t> values;
+    for (int i = 0; i != 9; ++i) values.push_back(stream());
+    EXPECT_EQ(9U, stream.position());
+
+    // Any position can be reached directly, e.g. by a thread starting in the middle of a range
+    gSparse::Util::RandomStream other(123, 4);
+    other.seek(5);
+    EXPECT_EQ(values[5], other());
+    other.discard(2);
+    EXPECT_EQ(values[8], other());
+
+    // Different stream ids and seeds are different sequences
+    gSparse::Util::RandomStream sub = stream.substream(5);
+    EXPECT_NE(values[0], sub());
+    gSparse::Util::RandomStream seed(124, 4);
+    EXPECT_NE(values[0], seed());
+}
+
+TEST(Random,Ranges)
+{
+    gSparse::Util::RandomStream stream(7);
+    for (int i = 0; i != 1000; ++i)
+    {
+        double u = stream.uniform();
+        EXPECT_GE(u, 0.0);
+        EXPECT_LT(u, 1.0);
+        EXPECT_LT(stream.index(10), 10U);
+    }
+    EXPECT_EQ(0U, gSparse::Util::toIndex(0, 10));
+    EXPECT_EQ(9U, gSparse::Util::toIndex(~0ULL, 10));
+}
+
+TEST(Random,GlobalSeed)
+{
+    gSparse::Util::setGlobalSeed(99);
+    std::uint64_t a = gSparse::Util::nextSeed();
+    std::uint64_t b = gSparse::Util::nextSeed();
+    EXPECT_NE(a, b);
+    gSparse::Util::setGlobalSeed(99);
+    EXPECT_EQ(a, gSparse::Util::nextSeed());
+    EXPECT_EQ(b, gSparse::Util::nextSeed());
+    EXPECT_NE(gSparse::Util::deriveSeed(a, 0), gSparse::Util::deriveSeed(a, 1));
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
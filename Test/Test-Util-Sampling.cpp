@@ -5,11 +5,49 @@
 #include <gtest/gtest.h>
 #include <gSparse/Util/Sampling.hpp>
 
+#include <vector>
+
 TEST(Util,Sampling)
 {
 	// Just make sure that they run without crashing.
-	// TODO: Find a way to test these random generators
 	std::discrete_distribution<int> distribution{ 1,2,3 };
-	EXPECT_NO_THROW(gSparse::Util::sampleDiscreteDistribution(distribution));
+	EXPECT_NO_THROW(gSparse::Util::sample(distribution));
+}
+
+TEST(Util,AliasTable)
+{
+	// Zero weights are never drawn. Other outcomes follow their weights.
+	std::vector<double> weights{ 1.0, 0.0, 2.0, 3.0, 0.5, 1.5 };
+	gSparse::Util::AliasTable table(weights.begin(), weights.end());
+	EXPECT_EQ(weights.size(), table.size());
+
+	std::mt19937_64 engine(42);
+	std::vector<std::size_t> count(weights.size(), 0);
+	const std::size_t draws = 200000;
+	for (std::size_t i = 0; i != draws; ++i) ++count[table(engine)];
+	EXPECT_EQ(0, count[1]);
+	for (std::size_t i = 0; i != weights.size(); ++i)
+		EXPECT_NEAR(weights[i] / 8.0, static_cast<double>(count[i]) / draws, 0.01);
+
+	EXPECT_LT(gSparse::Util::sample(table), weights.size());
 }
 
+TEST(Util,AliasTableDegenerate)
+{
+	// A single outcome, and all-zero weights which fall back to uniform sampling
+	std::vector<double> one{ 5.0 };
+	gSparse::Util::AliasTable single(one.begin(), one.end());
+	EXPECT_EQ(0, single.lookup(0));
+	EXPECT_EQ(0, single.lookup(~0ULL));
+
+	std::vector<double> zeros(4, 0.0);
+	gSparse::Util::AliasTable uniform(zeros.begin(), zeros.end());
+	EXPECT_EQ(0, uniform.lookup(0));
+	EXPECT_EQ(3, uniform.lookup(~0ULL));
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
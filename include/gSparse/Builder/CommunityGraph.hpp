@@ -8,6 +8,7 @@
 #include "../Config.hpp"
 #include "../UndirectedGraph.hpp"
 #include "CompleteGraph.hpp"
+#include "../Util/Random.hpp"
 
 #include <random>
 #include <fstream>
@@ -57,10 +58,12 @@ namespace gSparse
         ///
         /// This function builds a random community graph and write to a file
 		/// TODO: This function requires a clean-up / refactor.
+		/// The same seed always yields the same graph. Default seed is gSparse::Util::nextSeed().
         ///
-		void createRandomGraph(int total_community = 3, int bridges = 4, int community_size = 30, const std::string & name="random.csv")
+		void createRandomGraph(int total_community = 3, int bridges = 4, int community_size = 30, const std::string & name="random.csv",
+			std::uint64_t seed = gSparse::Util::nextSeed())
 		{
-			std::default_random_engine generator;
+			gSparse::Util::RandomStream generator(seed);
 
 			for (int i = 1; i != 2; ++i)
 			{
@@ -72,9 +75,8 @@ namespace gSparse
 				//Each community is currently a complete graph to represent a dense graph. This can be sparsify safety through uniform sampling.
 				auto g = gSparse::Builder::buildUnitCompleteGraph(i * community_size);
 				
-				//Connecting the bridges via uniform sampling
+				//Connecting the bridges via uniform sampling of a node in each community
 				int offset = g->GetNodeCount();
-				std::uniform_int_distribution<int> distribution(0, offset);
 
 				for (int community_id = 0; community_id != total_community; ++community_id)
 				{
@@ -94,7 +96,7 @@ namespace gSparse
 							for (int l = 0; l != bridges; ++l)
 							{
 								std::stringstream ss;
-								ss << j * offset + distribution(generator) << " " << k * offset + distribution(generator);
+								ss << j * offset + generator.index(offset) << " " << k * offset + generator.index(offset);
 								myfile << stringCleaner(ss.str()) << std::endl;
 							}
 						}
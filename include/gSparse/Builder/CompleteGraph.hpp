@@ -3,9 +3,11 @@
 
 #include "../Config.hpp"
 #include "../UndirectedGraph.hpp"
-#include "../Util/Sampling.hpp"
+#include "../CompleteGraph.hpp"
+#include "../Util/Random.hpp"
 
 #include <random>
+#include <utility>  // std::move
 
 namespace gSparse
 {
@@ -34,7 +36,17 @@ namespace gSparse
 					}
 				}
 			}
-			return std::make_shared<gSparse::UndirectedGraph>(resultEdge);
+			return std::make_shared<gSparse::UndirectedGraph>(std::move(resultEdge));
+		}
+        /// \ingroup Builder
+        ///
+        /// This function builds an implicit complete graph, which stores no edges. See gSparse::CompleteGraph.
+        /// \param nodeCount  Number of nodes in the Complete graph. Must be at least two.
+        /// \param weight     Weight of every edge. Default is one.
+        ///
+		inline gSparse::Graph buildImplicitCompleteGraph(std::size_t nodeCount, gSparse::PRECISION weight = 1)
+		{
+			return std::make_shared<gSparse::CompleteGraph>(nodeCount, weight);
 		}
         /// \ingroup Builder
         ///
@@ -42,7 +54,9 @@ namespace gSparse
         /// \param nodeCount  Number of nodes in the Complete graph 
         /// \param lower_weight lower bound of the weight to randomize. The value must be greater than zero.
         /// \param upper_weight upper bound of the weight to randomize. The value must be greater than zero.
-        inline gSparse::Graph buildRandomCompleteGraph(std::size_t nodeCount, double lower_weight, double upper_weight)
+        /// \param seed Seed of the weights. The same seed always yields the same graph. Default is gSparse::Util::nextSeed().
+        inline gSparse::Graph buildRandomCompleteGraph(std::size_t nodeCount, double lower_weight, double upper_weight,
+            std::uint64_t seed = gSparse::Util::nextSeed())
 		{
             std::size_t & n = nodeCount;
 
@@ -55,7 +69,7 @@ namespace gSparse
 			gSparse::EdgeMatrix resultEdge = gSparse::EdgeMatrix((n * (n - 1)) / 2, 2);
             gSparse::PrecisionRowMatrix resultWeight = gSparse::PrecisionRowMatrix((n * (n - 1)) / 2, 1);
 			std::size_t row = 0;
-            std::uniform_real_distribution<double> dist(lower_weight, upper_weight);
+            gSparse::Util::RandomStream stream(seed);
 			for (std::size_t i = 0; i != n; ++i)
 			{
 				for (std::size_t j = 0; j != n; ++j)
@@ -64,12 +78,12 @@ namespace gSparse
 					{
 						resultEdge(row, 0) = i;
 						resultEdge(row, 1) = j;
-                        resultWeight(row) = gSparse::Util::sample(dist);
+                        resultWeight(row) = lower_weight + (upper_weight - lower_weight) * stream.uniform();
 						++row;
 					}
 				}
 			}
-			return std::make_shared<gSparse::UndirectedGraph>(resultEdge,resultWeight);
+			return std::make_shared<gSparse::UndirectedGraph>(std::move(resultEdge), std::move(resultWeight));
 		}
 	}
 }
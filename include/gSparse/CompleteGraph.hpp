@@ -0,0 +1,173 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_COMPLETEGRAPH_HPP
+#define GSPARSE_COMPLETEGRAPH_HPP
+
+#include <Eigen/Dense>
+
+#include <exception>  // For exception handling
+#include <cstddef>    // size_t definition
+#include <cstdint>
+#include <cmath>      // sqrt
+#include <memory>     // Shared_ptr
+#include <atomic>
+#include <mutex>      // call_once
+#include <algorithm>  // std::max, std::swap
+#include <cassert>
+#include <utility>    // std::pair, std::move
+
+#include "Config.hpp"
+#include "Interface/Graph.hpp"
+#include "UndirectedGraph.hpp"  // Materialized representation
+
+namespace gSparse
+{
+    //! An implicit Complete Graph class
+    /*!
+        This class represents the complete graph on n nodes with the same weight w on every edge, without storing
+        its n(n-1)/2 edges. Edge k is the k-th pair (i, j), i < j, in row-major order, the order used by
+        gSparse::Builder::buildUnitCompleteGraph. EdgeAt and EdgeIndex map between the two.
+
+        The Laplacian is w(nI - J), so ApplyLaplacian computes L * x = w(n x - sum(x) 1) in O(n) per column,
+        and every effective resistance is 2 / (nw), which gSparse::ER calculators return without solving.
+        The IGraph getters still work: the first call to one of them materializes the edge and weight lists
+        and the matrices as an UndirectedGraph, which costs as much as building the graph explicitly.
+    */
+    class CompleteGraph : public IGraph
+    {
+    public:
+        // Disallow default constructor
+        CompleteGraph() = delete;
+        //! Constructor
+        /*!
+        \param nodeCount: Number of nodes. Must be at least two.
+        \param weight: Weight of every edge. Must be positive. Default is one.
+        */
+        explicit CompleteGraph(std::size_t nodeCount, gSparse::PRECISION weight = 1) :
+            _nodeCount(nodeCount),
+            _weight(weight)
+        {
+            if (nodeCount < 2)
+                throw std::invalid_argument("CompleteGraph: nodeCount must be at least two");
+            if (!(weight > 0))
+                throw std::invalid_argument("CompleteGraph: weight must be positive");
+        }
+
+        //! Return the number of Edges in the Graph
+        virtual inline std::size_t GetEdgeCount() const { return _nodeCount * (_nodeCount - 1) / 2; }
+        //! Return the number of Nodes in the Graph
+        virtual inline std::size_t GetNodeCount() const { return _nodeCount; }
+        //! Return the weight of every edge
+        inline gSparse::PRECISION GetWeight() const { return _weight; }
+        //! Return the effective resistance of every edge, 2 / (nw)
+        inline gSparse::PRECISION GetEffectiveResistance() const
+        {
+            return static_cast<gSparse::PRECISION>(2.0 / (static_cast<double>(_nodeCount) * _weight));
+        }
+
+        //! Return the nodes (i, j), i < j, of edge k
+        inline std::pair<std::size_t, std::size_t> EdgeAt(std::size_t k) const
+        {
+            #ifndef NDEBUG
+                assert(k < GetEdgeCount());
+            #endif
+            // Solve _rowOffset(i) <= k for the largest i, then correct the rounding of the square root
+            const double n = static_cast<double>(_nodeCount);
+            const double root = std::sqrt((2.0 * n - 1.0) * (2.0 * n - 1.0) - 8.0 * static_cast<double>(k));
+            std::size_t i = static_cast<std::size_t>(std::max(0.0, std::floor((2.0 * n - 1.0 - root) / 2.0)));
+            if (i > _nodeCount - 2) i = _nodeCount - 2;
+            while (i != 0 && _rowOffset(i) > k) --i;
+            while (i + 1 < _nodeCount - 1 && _rowOffset(i + 1) <= k) ++i;
+            return std::make_pair(i, i + 1 + (k - _rowOffset(i)));
+        }
+        //! Return the index of the edge between nodes i and j, i != j
+        inline std::size_t EdgeIndex(std::size_t i, std::size_t j) const
+        {
+            #ifndef NDEBUG
+                assert(i != j && i < _nodeCount && j < _nodeCount);
+            #endif
+            if (i > j) std::swap(i, j);
+            return _rowOffset(i) + (j - i - 1);
+        }
+        //! Compute L * x = w(n x - sum(x) 1) for every column of x, without building L
+        template <typename Derived>
+        inline gSparse::PrecisionMatrix ApplyLaplacian(const Eigen::MatrixBase<Derived> & x) const
+        {
+            #ifndef NDEBUG
+                assert(static_cast<std::size_t>(x.rows()) == _nodeCount);
+            #endif
+            const gSparse::PRECISION n = static_cast<gSparse::PRECISION>(_nodeCount);
+            gSparse::PrecisionMatrix result = n * x;
+            result.rowwise() -= x.colwise().sum();
+            return _weight * result;
+        }
+
+        //! Return Graph's Adjancency Matrix. The graph is materialized on first access.
+        virtual inline const gSparse::SparsePrecisionMatrix & GetAdjacentMatrix() const { return _materialized().GetAdjacentMatrix(); }
+        //! Return Graph's Incident Matrix. The graph is materialized on first access.
+        virtual inline const gSparse::SparsePrecisionMatrix & GetIncidentMatrix() const { return _materialized().GetIncidentMatrix(); }
+        //! Return Graph's Degree Matrix. The graph is materialized on first access.
+        virtual inline const gSparse::SparsePrecisionMatrix & GetDegreeMatrix() const { return _materialized().GetDegreeMatrix(); }
+        //! Return Graph's Laplacian Matrix. The graph is materialized on first access.
+        virtual inline const gSparse::SparsePrecisionMatrix & GetLaplacianMatrix() const { return _materialized().GetLaplacianMatrix(); }
+        //! Return Graph's Weight Matrix. The graph is materialized on first access.
+        virtual inline const gSparse::SparsePrecisionMatrix & GetWeightMatrix() const { return _materialized().GetWeightMatrix(); }
+        //! Return Graph's Edge List Matrix. The graph is materialized on first access.
+        virtual inline gSparse::EdgeList GetEdgeList() const { return _materialized().GetEdgeList(); }
+        //! Return Graph's Weight List Matrix. The graph is materialized on first access.
+        virtual inline gSparse::WeightList GetWeightList() const { return _materialized().GetWeightList(); }
+        //! Return true if the graph has been materialized by an IGraph getter
+        inline bool IsMaterialized() const { return _ready.load(std::memory_order_acquire); }
+
+        // A destructor
+        virtual ~CompleteGraph() = default;
+    private:
+        std::size_t _nodeCount;                                 //!< number of vertices
+        gSparse::PRECISION _weight;                             //!< weight of every edge
+        mutable std::once_flag _materializeOnce;                //!< builds _graph once
+        mutable std::shared_ptr<gSparse::UndirectedGraph> _graph;  //!< explicit graph, built on first access
+        mutable std::atomic<bool> _ready{false};                //!< whether _graph has been built
+
+        //! Number of edges (i', j) with i' < i
+        inline std::size_t _rowOffset(std::size_t i) const { return i * (2 * _nodeCount - i - 1) / 2; }
+        //! Return the explicit graph, building it first if needed. Concurrent callers build it only once.
+        inline const gSparse::UndirectedGraph & _materialized() const
+        {
+            std::call_once(_materializeOnce, [this]()
+            {
+                const std::size_t m = GetEdgeCount();
+                gSparse::EdgeMatrix edges(static_cast<Eigen::Index>(m), 2);
+                std::size_t row = 0;
+                for (std::size_t i = 0; i != _nodeCount; ++i)
+                {
+                    for (std::size_t j = i + 1; j != _nodeCount; ++j)
+                    {
+                        edges(row, 0) = static_cast<gSparse::NodeIndex>(i);
+                        edges(row, 1) = static_cast<gSparse::NodeIndex>(j);
+                        ++row;
+                    }
+                }
+                gSparse::PrecisionRowMatrix weights = gSparse::PrecisionRowMatrix::Constant(static_cast<Eigen::Index>(m), 1, _weight);
+                _graph = std::make_shared<gSparse::UndirectedGraph>(std::move(edges), std::move(weights));
+                _ready.store(true, std::memory_order_release);
+            });
+            return *_graph;
+        }
+    };
+
+    //! Fill er with the closed-form effective resistances of an implicit CompleteGraph.
+    /*!
+    \return false, leaving er unchanged, if graph is not a gSparse::CompleteGraph.
+    */
+    inline bool closedFormER(gSparse::PrecisionRowMatrix & er, const gSparse::Graph & graph)
+    {
+        const gSparse::CompleteGraph * complete = dynamic_cast<const gSparse::CompleteGraph *>(graph.get());
+        if (complete == nullptr) return false;
+        er = gSparse::PrecisionRowMatrix::Constant(static_cast<Eigen::Index>(complete->GetEdgeCount()), 1,
+            complete->GetEffectiveResistance());
+        return true;
+    }
+}
+#endif
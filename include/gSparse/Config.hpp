@@ -6,16 +6,24 @@
 #define GSPARSE_CONFIG_HPP
 
 #include <cstddef>
+#include <cstdint>
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
 
+#ifndef GSPARSE_PRECISION
+    #define GSPARSE_PRECISION double
+#endif
+#ifndef GSPARSE_NODE_INDEX
+    #define GSPARSE_NODE_INDEX std::uint32_t
+#endif
+
 namespace gSparse
 {
     //! PRECISION Definition
     /*! PRECISION is a typedef of a data type used by gSparse. 
-        This can be modified by CMake build option. It is default to double.
+        This can be modified by CMake build option GSPARSE_PRECISION (or by defining the GSPARSE_PRECISION macro). It is default to double.
     */
-    typedef double PRECISION;
+    typedef GSPARSE_PRECISION PRECISION;
 
     //! PrecisionMatrix Definition
     /*! PrecisionMatrix is a typedef of Eigen::Matrix<gSparse::PRECISION, -1, -1>
@@ -25,11 +33,34 @@ namespace gSparse
 
     typedef Eigen::Matrix<gSparse::PRECISION, Eigen::Dynamic, Eigen::Dynamic,Eigen::RowMajor> PrecisionRowMatrix;
 
-    //! EdgeMatrix Definition
-    /*! EdgeMatrix is a typedef of Eigen::Matrix<gSparse::PRECISION, -1, -1>
+    //! PrecisionVector Definition
+    /*! PrecisionVector is a typedef of Eigen::Matrix<gSparse::PRECISION, -1, 1>
     *   This is to shorten the code for readability.
     */
-    typedef Eigen::Matrix<std::size_t, Eigen::Dynamic, Eigen::Dynamic> EdgeMatrix;
+    typedef Eigen::Matrix<gSparse::PRECISION, Eigen::Dynamic, 1> PrecisionVector;
+
+    //! NodeIndex Definition
+    /*! NodeIndex is the integer type of a node in an edge list.
+    *   It is std::uint32_t unless GSPARSE_NODE_INDEX is defined, for example by the GSPARSE_NODE_INDEX CMake option.
+    *   Sparse matrices use 32-bit indices, so 32 bits address every node of a graph gSparse can build.
+    */
+    typedef GSPARSE_NODE_INDEX NodeIndex;
+
+    //! EdgeMatrix Definition
+    /*! EdgeMatrix is a typedef of Eigen::Matrix<gSparse::NodeIndex, -1, -1, Eigen::RowMajor>
+    *   An edge list has one row per edge and two columns. It is stored row by row, so both end points of an edge are adjacent in memory.
+    */
+    typedef Eigen::Matrix<gSparse::NodeIndex, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> EdgeMatrix;
+
+    //! EdgeList Definition
+    /*! EdgeList is a read-only view of an EdgeMatrix, owned by a graph or by the caller. It does not copy the edges.
+    */
+    typedef Eigen::Map<const EdgeMatrix> EdgeList;
+
+    //! WeightList Definition
+    /*! WeightList is a read-only view of an m x 1 PrecisionRowMatrix, owned by a graph or by the caller.
+    */
+    typedef Eigen::Map<const PrecisionRowMatrix> WeightList;
 
     //! SparsePrecisionMatrix Definition
     /*! EdgeMatrix is a typedef of Eigen::SparseMatrix<gSparse::PRECISION>
@@ -8,10 +8,18 @@
 
 #include "../Interface/EffectiveResistance.hpp"
 #include "../Config.hpp"
+#include "../CompleteGraph.hpp"  // Closed-form effective resistance
 #include "../Util/JL.hpp"  // Building Random Projection
 
 // Approximate ER Policies
 #include "Policy/AproxERSLMJacobiCG.hpp"
+#include "Policy/AproxER_SPL.hpp"
+#include "Policy/AproxERSLMMixedCG.hpp"
+
+// Preconditioners
+#include "../Preconditioner/IncompleteCholesky.hpp"
+#include "../Preconditioner/SpanningTree.hpp"
+#include "../Preconditioner/AggregationAMG.hpp"
 
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
@@ -24,18 +32,28 @@ namespace gSparse
         ///
         /// This class calculates Approxmation of Graph's Effective Resistance.
         /// There are many approach to this problem. Such approach is set via class Policy.
+        /// Public members of the Policy, such as AproxERSLMPCG::SetThreadCount, are available to users.
         template <typename Policy> 
-        class _ApproximateER : public IEffectiveResistance, private Policy
+        class _ApproximateER : public IEffectiveResistance, public Policy
         {
         public:
             using Policy::_calculateER;
+            using Policy::GetSeed;
             inline gSparse::COMPUTE_INFO CalculateER( gSparse::PrecisionRowMatrix & er,
                 const gSparse::Graph & graph)
             {
+                // Complete graphs have a closed form
+                if (gSparse::closedFormER(er, graph)) return gSparse::SUCCESSFUL;
                 return _calculateER(er, graph);
             }
+            inline void SetSeed(std::uint64_t seed) override { Policy::SetSeed(seed); }
         };
         typedef _ApproximateER<Policy::AproxERSLMJacobiCG> ApproximateER; //<! ApproximateER class to calculate effective resistance
+        typedef _ApproximateER<Policy::AproxERSLMPCG<gSparse::Preconditioner::IncompleteCholesky>> ApproximateERIncompleteCholesky; //<! ApproximateER with incomplete Cholesky preconditioner
+        typedef _ApproximateER<Policy::AproxERSLMPCG<gSparse::Preconditioner::SpanningTree>> ApproximateERSpanningTree; //<! ApproximateER with augmented spanning tree preconditioner
+        typedef _ApproximateER<Policy::AproxERSLMPCG<gSparse::Preconditioner::AggregationAMG>> ApproximateERAMG; //<! ApproximateER with algebraic multigrid preconditioner
+        typedef _ApproximateER<Policy::AproxERSPL> ApproximateERSPL; //<! ApproximateER with approximate Cholesky preconditioner
+        typedef _ApproximateER<Policy::AproxERSLMMixedJacobiCG> ApproximateERMixed; //<! ApproximateER solved in float with double refinement
     }
 }
 #endif
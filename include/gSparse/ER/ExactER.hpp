@@ -6,13 +6,24 @@
 #define GSPARSE_ER_EXACTER_HPP
 
 #include "../Config.hpp"
+#include "../CompleteGraph.hpp"  // Closed-form effective resistance
 
 #include "../Interface/EffectiveResistance.hpp"
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
 
 #include <iostream>
+
+// Exact ER Policies
 #include "Policy/ExactERJacobiCG.hpp"
+#include "Policy/ExactERLDLT.hpp"
+
+// Preconditioners
+#include "../Preconditioner/IncompleteCholesky.hpp"
+#include "../Preconditioner/SpanningTree.hpp"
+#include "../Preconditioner/AggregationAMG.hpp"
+#include "../Preconditioner/ApproximateCholesky.hpp"
+
 namespace gSparse 
 {
     namespace ER 
@@ -22,18 +33,26 @@ namespace gSparse
         /// This class calculates Exact value of Graph's Effective Resistance.
         /// There are many approach to this problem. Such approach is set via class Policy.
         /// Warning: The algorithm for calculating Exact Resistance is very slow. 
+        /// Public members of the Policy, such as ExactERLDLT::SetThreadCount, are available to users.
         template <typename Policy> 
-        class _ExactER : public IEffectiveResistance, private Policy
+        class _ExactER : public IEffectiveResistance, public Policy
         {
         public:
             using Policy::_calculateER;
             inline gSparse::COMPUTE_INFO CalculateER( gSparse::PrecisionRowMatrix & er,
                 const gSparse::Graph & graph)
             {
+                // Complete graphs have a closed form
+                if (gSparse::closedFormER(er, graph)) return gSparse::SUCCESSFUL;
                 return _calculateER(er, graph);
             }
         };
-        typedef _ExactER<Policy::ExactERJacobiCG> ExactER; //<! ExactER class to calculate effective resistance
+        typedef _ExactER<Policy::ExactERLDLT> ExactER; //<! ExactER class to calculate effective resistance
+        typedef _ExactER<Policy::ExactERJacobiCG> ExactERJacobiCG; //<! ExactER class using Jacobi preconditioned CG instead of a factorization
+        typedef _ExactER<Policy::ExactERPCG<gSparse::Preconditioner::IncompleteCholesky>> ExactERIncompleteCholesky; //<! ExactER with incomplete Cholesky preconditioned CG
+        typedef _ExactER<Policy::ExactERPCG<gSparse::Preconditioner::SpanningTree>> ExactERSpanningTree; //<! ExactER with augmented spanning tree preconditioned CG
+        typedef _ExactER<Policy::ExactERPCG<gSparse::Preconditioner::AggregationAMG>> ExactERAMG; //<! ExactER with algebraic multigrid preconditioned CG
+        typedef _ExactER<Policy::ExactERPCG<gSparse::Preconditioner::ApproximateCholesky>> ExactERApproximateCholesky; //<! ExactER with approximate Cholesky preconditioned CG
     }
 }
 #endif
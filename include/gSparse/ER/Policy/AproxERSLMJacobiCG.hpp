@@ -7,10 +7,16 @@
 #define GSPARSE_ER_POLICY_APROXERSLMJACOBICG_HPP
 
 #include "../../Config.hpp"
+#include "../../Interface/Graph.hpp"
 #include "../../Util/JL.hpp"  // Building Random Projection
+#include "../../Util/Random.hpp"  // Seeds of randomized preconditioners
+#include "../../Util/LaplacianOperator.hpp"  // Multithreaded Laplacian product
 
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
+
+#include <cmath>
+#include <cstdint>
 namespace gSparse 
 {
     namespace ER 
@@ -21,11 +27,30 @@ namespace gSparse
             ///
             /// This class Approximate Effective Weight Resistance
             /// Adaptation from http://ccom.uprrp.edu/~ikoutis/SpectralAlgorithms.htm.
-            /// The algorithm leverages Conjugated Graident with Jacobi preconditioner to solve linear system
+            /// The algorithm leverages Preconditioned Conjugated Graident to solve linear system.
+            /// The preconditioner is set up once and shared by all JL projections. Each projection is still
+            /// solved by its own CG run, so every projection pays for its own products with the Laplacian.
+            /// Preconditioner is any Eigen::ConjugateGradient preconditioner, such as those in gSparse::Preconditioner.
+            /// Products with the Laplacian inside CG run on multiple threads (see gSparse::Util::LaplacianOperator).
             ///
-            class AproxERSLMJacobiCG
+            template <typename Preconditioner = Eigen::DiagonalPreconditioner<gSparse::PRECISION>>
+            class AproxERSLMPCG
             {
+            public:
+                /// Set number of threads computing products with the Laplacian.
+                /// \param threadCount Number of threads. Default is 0, which uses every hardware thread.
+                inline void SetThreadCount(std::size_t threadCount) { _threadCount = threadCount; }
+                /// Get number of threads computing products with the Laplacian. Zero means every hardware thread.
+                inline std::size_t GetThreadCount() const { return _threadCount; }
+                /// Set the seed of the JL projection and of a randomized preconditioner. The same seed always yields
+                /// the same effective resistance, regardless of the number of threads. Default is gSparse::Util::nextSeed().
+                inline void SetSeed(std::uint64_t seed) { _seed = seed; }
+                /// Get the seed of the JL projection and of a randomized preconditioner.
+                inline std::uint64_t GetSeed() const { return _seed; }
             protected:
+                std::size_t _threadCount = 0; //!< Number of threads. Zero means every hardware thread.
+                std::uint64_t _seed = gSparse::Util::nextSeed(); //!< Seed of the JL projection
+
                 /// This function calculates Effective Resistance and return computation status.
                 /// \param er A row matrix to receive the EffectiveResistance value
                 /// \param graph A std::shared_ptr<IGraph> object representing the graph to calculate resistance
@@ -45,41 +70,45 @@ namespace gSparse
                     std::size_t scale = static_cast<size_t>(
                                 std::ceil(
                                 std::log2(
-                                static_cast<double>(graph->GetIncidentMatrix().cols()) / eps)));
+                                static_cast<double>(graph->GetNodeCount()) / eps)));
+                    if (scale < 1) scale = 1;
 
-                    for (int i = 1; i != scale + 1; ++i)
-                    {
-                        Eigen::VectorXd x;
-                        gSparse::PrecisionMatrix Q =
-                        gSparse::Util::randomProjectionMatrix(1, 
-                                                                graph->GetIncidentMatrix().rows(), 
-                                                                static_cast<double>(scale), 
-                                                                JLTol);
+                    // Project all JL rows at once, Y = B^T * W^(1/2) * Q^T (n x scale).
+                    // Q is implicit: its entries are generated on the fly while iterating over the edge list.
+                    gSparse::PrecisionMatrix Y =
+                    gSparse::Util::implicitProjection(graph->GetEdgeList(),
+                                                        graph->GetWeightList(),
+                                                        graph->GetNodeCount(),
+                                                        scale,
+                                                        static_cast<double>(scale),
+                                                        JLTol,
+                                                        _seed);
 
-                        gSparse::PrecisionMatrix Y = (Q * graph->GetWeightMatrix().cwiseSqrt() * graph->GetIncidentMatrix());
+                    // Set up the preconditioner once. solve() then runs CG on each column of Y in turn.
+                    gSparse::Util::LaplacianOperator laplacian(graph->GetLaplacianMatrix(), _threadCount);
+                    Eigen::ConjugateGradient<gSparse::Util::LaplacianOperator, Eigen::Lower | Eigen::Upper, Preconditioner> cg;
+                    cg.setMaxIterations(maxIter);
+                    gSparse::Util::setSeedIfRandomized(cg.preconditioner(), gSparse::Util::deriveSeed(_seed, 1));
+                    cg.compute(laplacian);
+                    // Columns that do not converge within maxIter keep their last iterate
+                    gSparse::PrecisionMatrix X = cg.solve(Y);
 
-                        // solve Linear system with 300 max iteration
-                        Eigen::ConjugateGradient<gSparse::SparsePrecisionMatrix, Eigen::Lower | Eigen::Upper  > cg;
-                        cg.setMaxIterations(maxIter);
-                        x = cg.compute(graph->GetLaplacianMatrix()).solve(Y.transpose());
-                                    
-                        if (cg.info() != Eigen::Success)
-                        {
-                            // Does not converge this iteration. Keeps going.
-                            continue;
-                        }
-                        for (std::size_t j = 0; j != graph->GetEdgeCount(); ++j)
-                        {
-                            er(j) += pow(std::abs(x(graph->GetEdgeList()(j, 0)) - x(graph->GetEdgeList()(j, 1))), 2.0f);
-                        }
+                    const auto & edges = graph->GetEdgeList();
+                    for (std::size_t j = 0; j != graph->GetEdgeCount(); ++j)
+                    {
+                        er(j) = (X.row(edges(j, 0)) - X.row(edges(j, 1))).squaredNorm();
                     }
                     // Non finite element goes to zero
-                    er = er.unaryExpr([](double v) { return std::isfinite(v)? v : 0.0; });
-                    if (er.rows() != graph->GetEdgeCount())
-                        return gSparse::NOT_CONVERGING;
-                    return gSparse::SUCCESSFUL;       
+                    er = er.unaryExpr([](gSparse::PRECISION v) { return std::isfinite(v)? v : gSparse::PRECISION(0); });
+                    return gSparse::SUCCESSFUL;
                 }
             };
+
+            /// \ingroup EffectiveResistance
+            ///
+            /// Approximate Effective Weight Resistance with Jacobi preconditioned Conjugated Gradient.
+            ///
+            typedef AproxERSLMPCG<Eigen::DiagonalPreconditioner<gSparse::PRECISION>> AproxERSLMJacobiCG;
         }
     }
 }
@@ -0,0 +1,151 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_ER_POLICY_APROXERSLMMIXEDCG_HPP
+#define GSPARSE_ER_POLICY_APROXERSLMMIXEDCG_HPP
+
+#include "../../Config.hpp"
+#include "../../Interface/Graph.hpp"
+#include "../../Util/JL.hpp"  // Building Random Projection
+#include "../../Util/Random.hpp"  // Seeds of randomized preconditioners
+#include "../../Util/LaplacianOperator.hpp"  // Multithreaded Laplacian product
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <Eigen/IterativeLinearSolvers>
+
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+namespace gSparse
+{
+    namespace ER
+    {
+        namespace Policy
+        {
+            /// \ingroup EffectiveResistance
+            ///
+            /// Approximate Effective Weight Resistance solved in mixed precision.
+            /// The JL projections are the same as AproxERSLMPCG. CG runs in gSparse::PRECISION on a copy of the Laplacian
+            /// stored in StorageScalar (float), so each product reads half the bytes of matrix values while its sums are
+            /// accumulated in full precision (see gSparse::Util::BasicLaplacianOperator).
+            /// Rounding the Laplacian limits how accurately CG solves the original system. Iterative refinement
+            /// recomputes the residual with the full precision Laplacian and solves for a correction, until the relative
+            /// residual reaches the tolerance. CG iterations of all refinement steps share the maxIter budget of a column,
+            /// so a solve never costs more iterations than AproxERSLMPCG.
+            /// Preconditioner is any Eigen::ConjugateGradient preconditioner, such as those in gSparse::Preconditioner.
+            ///
+            template <typename Preconditioner = Eigen::DiagonalPreconditioner<gSparse::PRECISION>, typename StorageScalar = float>
+            class AproxERSLMMixedPCG
+            {
+            public:
+                /// Set number of threads computing products with the Laplacian.
+                /// \param threadCount Number of threads. Default is 0, which uses every hardware thread.
+                inline void SetThreadCount(std::size_t threadCount) { _threadCount = threadCount; }
+                /// Get number of threads computing products with the Laplacian. Zero means every hardware thread.
+                inline std::size_t GetThreadCount() const { return _threadCount; }
+                /// Set the seed of the JL projection and of a randomized preconditioner. Default is gSparse::Util::nextSeed().
+                inline void SetSeed(std::uint64_t seed) { _seed = seed; }
+                /// Get the seed of the JL projection and of a randomized preconditioner.
+                inline std::uint64_t GetSeed() const { return _seed; }
+                /// Set the relative residual at which a solve stops. Default is 1e-6.
+                inline void SetTolerance(double tolerance) { _tolerance = tolerance; }
+                /// Get the relative residual at which a solve stops.
+                inline double GetTolerance() const { return _tolerance; }
+                /// Get the largest number of refinement steps taken by a column in the last calculation.
+                inline int GetRefinements() const { return _refinements; }
+            protected:
+                std::size_t _threadCount = 0; //!< Number of threads. Zero means every hardware thread.
+                std::uint64_t _seed = gSparse::Util::nextSeed(); //!< Seed of the JL projection
+                double _tolerance = 1e-6;     //!< Relative residual of each solve
+                int _refinements = 0;         //!< Refinement steps taken by the last calculation
+
+                /// This function calculates Effective Resistance and return computation status.
+                /// \param er A row matrix to receive the EffectiveResistance value
+                /// \param graph A std::shared_ptr<IGraph> object representing the graph to calculate resistance
+                /// \param eps Error tolerance for conjugated gradient. Default is 1.0f.
+                /// \param JLTol Tolerance for JL projection Matrix. Default is 0.5f. (See http://ccom.uprrp.edu/~ikoutis/SpectralAlgorithms.htm.)
+                /// \param maxIter  Maximum iteration for conjugated gradient. Default is 300 iterations.
+                inline gSparse::COMPUTE_INFO _calculateER(
+                    gSparse::PrecisionRowMatrix & er,
+                    const gSparse::Graph & graph,
+                    double eps = 1.0f,
+                    double JLTol = 0.5,
+                    int maxIter = 300
+                    )
+                {
+                    er = gSparse::PrecisionRowMatrix::Zero(graph->GetEdgeCount(), 1);
+
+                    std::size_t scale = static_cast<size_t>(
+                                std::ceil(
+                                std::log2(
+                                static_cast<double>(graph->GetNodeCount()) / eps)));
+                    if (scale < 1) scale = 1;
+
+                    // Y = B^T * W^(1/2) * Q^T (n x scale), as in AproxERSLMPCG
+                    gSparse::PrecisionMatrix Y =
+                    gSparse::Util::implicitProjection(graph->GetEdgeList(),
+                                                        graph->GetWeightList(),
+                                                        graph->GetNodeCount(),
+                                                        scale,
+                                                        static_cast<double>(scale),
+                                                        JLTol,
+                                                        _seed);
+
+                    const gSparse::SparsePrecisionMatrix & laplacian = graph->GetLaplacianMatrix();
+                    const Eigen::SparseMatrix<StorageScalar> storedLaplacian = laplacian.template cast<StorageScalar>();
+                    gSparse::Util::LaplacianOperator fullOperator(laplacian, _threadCount);
+                    gSparse::Util::BasicLaplacianOperator<gSparse::PRECISION, StorageScalar> mixedOperator(storedLaplacian, _threadCount);
+                    Eigen::ConjugateGradient<gSparse::Util::BasicLaplacianOperator<gSparse::PRECISION, StorageScalar>,
+                        Eigen::Lower | Eigen::Upper, Preconditioner> cg;
+                    gSparse::Util::setSeedIfRandomized(cg.preconditioner(), gSparse::Util::deriveSeed(_seed, 1));
+                    cg.compute(mixedOperator);
+
+                    gSparse::PrecisionMatrix X = gSparse::PrecisionMatrix::Zero(Y.rows(), Y.cols());
+                    gSparse::PrecisionVector r(Y.rows()), d(Y.rows());
+                    _refinements = 0;
+                    for (Eigen::Index k = 0; k != Y.cols(); ++k)
+                    {
+                        const gSparse::PRECISION target = static_cast<gSparse::PRECISION>(_tolerance) * Y.col(k).norm();
+                        r = Y.col(k);
+                        Eigen::Index remaining = maxIter;
+                        int refinements = 0;
+                        // Solve L d = r on the stored Laplacian, then X += d and r = y - L X in full precision
+                        while (remaining > 0 && r.norm() > target)
+                        {
+                            d.setZero();
+                            cg.setMaxIterations(remaining);
+                            cg.setTolerance(target / r.norm());
+                            d = cg.solveWithGuess(r, d);
+                            const Eigen::Index iterations = cg.iterations();
+                            X.col(k) += d;
+                            r = Y.col(k);
+                            r.noalias() -= fullOperator * X.col(k);
+                            remaining -= std::max<Eigen::Index>(iterations, 1);
+                            ++refinements;
+                        }
+                        _refinements = std::max(_refinements, refinements - 1);
+                    }
+
+                    const auto & edges = graph->GetEdgeList();
+                    for (std::size_t j = 0; j != graph->GetEdgeCount(); ++j)
+                    {
+                        er(j) = (X.row(edges(j, 0)) - X.row(edges(j, 1))).squaredNorm();
+                    }
+                    // Non finite element goes to zero
+                    er = er.unaryExpr([](gSparse::PRECISION v) { return std::isfinite(v)? v : gSparse::PRECISION(0); });
+                    // Like AproxERSLMPCG, columns that reach maxIter keep their last iterate
+                    return gSparse::SUCCESSFUL;
+                }
+            };
+
+            /// \ingroup EffectiveResistance
+            ///
+            /// Approximate Effective Weight Resistance with Jacobi preconditioned mixed precision CG.
+            ///
+            typedef AproxERSLMMixedPCG<Eigen::DiagonalPreconditioner<gSparse::PRECISION>, float> AproxERSLMMixedJacobiCG;
+        }
+    }
+}
+#endif
@@ -5,26 +5,26 @@
 #ifndef GSPARSE_ER_POLICY_APPROXER_SPL_HPP
 #define GSPARSE_ER_POLICY_APPROXER_SPL_HPP
 
-#include "../Config.hpp"
+#include "../../Config.hpp"
+#include "../../Preconditioner/ApproximateCholesky.hpp"  // Approximate Laplacian factorization
+#include "AproxERSLMJacobiCG.hpp"                        // JL projection with preconditioned CG
 
-#include "../Interface/EffectiveResistance.hpp"
-#include <Eigen/Dense>
-#include <Eigen/Sparse>
-
-#include <iostream>
-
-namespace gSparse 
+namespace gSparse
 {
-    namespace ER 
+    namespace ER
     {
         namespace Policy
         {
-           /* 
-            TODO: Implement a Speilman Approximate Effective Resistance
-           */
-          
+            /// \ingroup EffectiveResistance
+            ///
+            /// Spielman-Srivastava Approximate Effective Resistance with a near-linear time Laplacian solver.
+            /// Original paper <https://arxiv.org/pdf/0803.0929.pdf>
+            /// The JL projections are solved by Conjugated Gradient preconditioned with
+            /// a randomized approximate Cholesky factorization of the Laplacian (see gSparse::Preconditioner::ApproximateCholesky).
+            ///
+            typedef AproxERSLMPCG<gSparse::Preconditioner::ApproximateCholesky> AproxERSPL;
         }
-        
+
     }
 }
 #endif
@@ -6,8 +6,14 @@
 #define GSPARSE_ER_POLICY_EXACTERJACOBICG_HPP
 
 #include "../../Config.hpp"
+#include "../../Interface/Graph.hpp"
+#include "../../Util/Parallel.hpp"  // Worker threads
+#include "../../Preconditioner/SharedPreconditioner.hpp"  // One preconditioner for every thread
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
+#include <Eigen/IterativeLinearSolvers>
+
+#include <cmath>
 
 namespace gSparse 
 {
@@ -19,16 +25,25 @@ namespace gSparse
             ///
             /// This class implements Spectral Sparsifier by Effective Weight Sampling.
             /// Adaptation from http://ccom.uprrp.edu/~ikoutis/SpectralAlgorithms.htm
-            /// The algorithm leverages Conjugated Graident with Jacobi preconditioner to solve linear system
+            /// The algorithm leverages Preconditioned Conjugated Graident to solve linear system.
+            /// Preconditioner is any Eigen::ConjugateGradient preconditioner, such as those in gSparse::Preconditioner.
+            /// Edges are split into contiguous slices, one per thread, which share the read-only preconditioner.
             ///
-            class ExactERJacobiCG
+            template <typename Preconditioner = Eigen::DiagonalPreconditioner<gSparse::PRECISION>>
+            class ExactERPCG
             {
+            public:
+                /// Set number of threads solving edges.
+                /// \param threadCount Number of threads. Default is 0, which uses every hardware thread.
+                inline void SetThreadCount(std::size_t threadCount) { _threadCount = threadCount; }
+                /// Get number of threads solving edges. Zero means every hardware thread.
+                inline std::size_t GetThreadCount() const { return _threadCount; }
             protected:
+                std::size_t _threadCount = 0; //!< Number of threads. Zero means every hardware thread.
+
                 /// This function calculates Effective Resistance and return computation status.
                 /// \param er A row matrix to receive the EffectiveResistance value
                 /// \param graph A std::shared_ptr<IGraph> object representing the graph to calculate resistance
-                /// \param eps Error tolerance for conjugated gradient. Default is 1.0f.
-                /// \param JLTol Tolerance for JL projection Matrix. Default is 0.5f. (See http://ccom.uprrp.edu/~ikoutis/SpectralAlgorithms.htm.)
                 /// \param maxIter  Maximum iteration for conjugated gradient. Default is 300 iterations.
                 inline gSparse::COMPUTE_INFO _calculateER(
                     gSparse::PrecisionRowMatrix & er,
@@ -37,21 +52,53 @@ namespace gSparse
                     )
                 {
                     er = gSparse::PrecisionRowMatrix::Zero(graph->GetEdgeCount(), 1);
-                    for (int i = 0; i != graph->GetEdgeCount(); ++i)
+
+                    // Set up the preconditioner once for all edges
+                    const gSparse::SparsePrecisionMatrix & laplacian = graph->GetLaplacianMatrix();
+                    Preconditioner preconditioner;
+                    preconditioner.compute(laplacian);
+
+                    // b is the incident row of an edge. It is built from the edge list
+                    // as row access of a column-major sparse matrix is expensive.
+                    // Each thread owns its vectors, a slice of edges and the matching slice of er.
+                    const auto & edges = graph->GetEdgeList();
+                    gSparse::Util::parallelFor(0, graph->GetEdgeCount(), _threadCount,
+                        [&](std::size_t begin, std::size_t end)
                     {
-                        Eigen::ConjugateGradient<gSparse::SparsePrecisionMatrix, Eigen::Lower | Eigen::Upper  > cg;
+                        // A solver per thread, as a solve updates the solver's state
+                        Eigen::ConjugateGradient<gSparse::SparsePrecisionMatrix, Eigen::Lower | Eigen::Upper,
+                            gSparse::Preconditioner::SharedPreconditioner<Preconditioner>> cg;
                         cg.setMaxIterations(maxIter);
-                        auto b = graph->GetIncidentMatrix().row(i);
-                        cg.compute(graph->GetLaplacianMatrix());
-                        Eigen::VectorXd x = cg.solve(b.transpose());
-                        b.toDense();
-                        er(i) = b.toDense() * x;
-                    }
+                        cg.setTolerance(Eigen::NumTraits<gSparse::PRECISION>::epsilon());
+                        cg.preconditioner().Share(preconditioner);
+                        cg.compute(laplacian);
+                        gSparse::PrecisionVector b = gSparse::PrecisionVector::Zero(graph->GetNodeCount());
+                        gSparse::PrecisionVector x = gSparse::PrecisionVector::Zero(graph->GetNodeCount());
+                        for (std::size_t i = begin; i != end; ++i)
+                        {
+                            std::size_t u = edges(i, 0);
+                            std::size_t v = edges(i, 1);
+                            if (u == v) continue;
+                            b(u) = 1.0;
+                            b(v) = -1.0;
+                            x.setZero();
+                            x = cg.solveWithGuess(b, x);
+                            er(i) = x(u) - x(v);
+                            b(u) = 0.0;
+                            b(v) = 0.0;
+                        }
+                    });
                     // Non finite number goes to zero
-                    er = er.unaryExpr([](double v) { return std::isfinite(v)? v : 0.0; });
+                    er = er.unaryExpr([](gSparse::PRECISION v) { return std::isfinite(v)? v : gSparse::PRECISION(0); });
                     return gSparse::SUCCESSFUL;
                 }
             };
+
+            /// \ingroup EffectiveResistance
+            ///
+            /// Exact Effective Weight Resistance with Jacobi preconditioned Conjugated Gradient.
+            ///
+            typedef ExactERPCG<Eigen::DiagonalPreconditioner<gSparse::PRECISION>> ExactERJacobiCG;
         }
         
     }
@@ -0,0 +1,96 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_ER_POLICY_EXACTERLDLT_HPP
+#define GSPARSE_ER_POLICY_EXACTERLDLT_HPP
+
+#include "../../Config.hpp"
+#include "../../Interface/Graph.hpp"
+#include "../../Util/Laplacian.hpp"  // Grounded Laplacian
+#include "../../Util/Parallel.hpp"   // Worker threads
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+#include <vector>
+#include <cmath>
+
+namespace gSparse
+{
+    namespace ER
+    {
+        namespace Policy
+        {
+            /// \ingroup EffectiveResistance
+            ///
+            /// This class calculates exact Effective Resistance with a sparse LDLT factorization.
+            /// The grounded Laplacian is factorized once, then the factorization is reused
+            /// to solve the linear system of every edge, one right-hand side at a time.
+            /// Right-hand sides are not batched: Eigen's sparse triangular solves process a dense panel column
+            /// by column, so a panel only adds memory.
+            /// Edges are split into contiguous slices, one per thread, which share the read-only factorization.
+            ///
+            class ExactERLDLT
+            {
+            public:
+                /// Set number of threads solving edges.
+                /// \param threadCount Number of threads. Default is 0, which uses every hardware thread.
+                inline void SetThreadCount(std::size_t threadCount) { _threadCount = threadCount; }
+                /// Get number of threads solving edges. Zero means every hardware thread.
+                inline std::size_t GetThreadCount() const { return _threadCount; }
+            protected:
+                std::size_t _threadCount = 0; //!< Number of threads. Zero means every hardware thread.
+
+                /// This function calculates Effective Resistance and return computation status.
+                /// \param er A row matrix to receive the EffectiveResistance value
+                /// \param graph A std::shared_ptr<IGraph> object representing the graph to calculate resistance
+                inline gSparse::COMPUTE_INFO _calculateER(
+                    gSparse::PrecisionRowMatrix & er,
+                    const gSparse::Graph & graph
+                    )
+                {
+                    er = gSparse::PrecisionRowMatrix::Zero(graph->GetEdgeCount(), 1);
+
+                    // Factorize the grounded Laplacian once
+                    gSparse::SparsePrecisionMatrix grounded;
+                    std::vector<Eigen::Index> reducedIndex;
+                    gSparse::Util::groundLaplacian(graph->GetLaplacianMatrix(), grounded, reducedIndex);
+
+                    Eigen::SimplicialLDLT<gSparse::SparsePrecisionMatrix> ldlt;
+                    ldlt.compute(grounded);
+                    if (ldlt.info() != Eigen::Success)
+                        return gSparse::NUMERICAL_ISSUE;
+
+                    const auto & edges = graph->GetEdgeList();
+                    const Eigen::Index reducedCount = grounded.rows();
+
+                    // Each thread owns its vectors, a slice of edges and the matching slice of er
+                    gSparse::Util::parallelFor(0, graph->GetEdgeCount(), _threadCount,
+                        [&](std::size_t begin, std::size_t end)
+                    {
+                        gSparse::PrecisionVector b = gSparse::PrecisionVector::Zero(reducedCount);
+                        gSparse::PrecisionVector x(reducedCount);
+                        for (std::size_t i = begin; i != end; ++i)
+                        {
+                            // Grounded nodes have zero potential and are not part of the system
+                            Eigen::Index u = reducedIndex[edges(i, 0)];
+                            Eigen::Index v = reducedIndex[edges(i, 1)];
+                            if (u == v) continue;
+                            if (u >= 0) b(u) = 1.0;
+                            if (v >= 0) b(v) = -1.0;
+                            x = ldlt.solve(b);
+                            er(i) = (u >= 0 ? x(u) : 0.0) - (v >= 0 ? x(v) : 0.0);
+                            if (u >= 0) b(u) = 0.0;
+                            if (v >= 0) b(v) = 0.0;
+                        }
+                    });
+                    // Non finite number goes to zero
+                    er = er.unaryExpr([](gSparse::PRECISION v) { return std::isfinite(v)? v : gSparse::PRECISION(0); });
+                    return gSparse::SUCCESSFUL;
+                }
+            };
+        }
+    }
+}
+#endif
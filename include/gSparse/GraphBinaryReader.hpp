@@ -0,0 +1,171 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_GRAPHBINARYREADER_HPP
+#define GSPARSE_GRAPHBINARYREADER_HPP
+
+#include <exception>  // Runtime_exception
+#include <sstream>    // Errror Message
+#include <string>
+#include <cstddef>    // size_t
+#include <cstdint>
+#include <cstring>    // memcpy
+#include <memory>     // shared_ptr
+#include <utility>    // std::move
+
+#include <Eigen/Sparse>
+
+#include "Config.hpp" // Library configuration
+#include "Interface/GraphReader.hpp"  // Baseclass definitions
+#include "UndirectedGraph.hpp"        // Graphs over mapped files
+#include "Util/BinaryGraph.hpp"       // File layout
+#include "Util/MappedFile.hpp"        // Memory-mapped input
+
+namespace gSparse
+{
+    //! An UndirectedGraph whose edge and weight lists live in a memory-mapped binary graph file
+    /*!
+        The graph keeps the file mapped for as long as it exists. A Laplacian stored in the file is loaded on
+        construction instead of being assembled on first access. Created by GraphBinaryReader::Load.
+    */
+    class MappedUndirectedGraph : public UndirectedGraph
+    {
+    public:
+        //! Constructor
+        /*!
+        \param file: A mapped binary graph file whose index and weight sizes match gSparse::NodeIndex and gSparse::PRECISION.
+        \param header: The validated header of file.
+        */
+        MappedUndirectedGraph(const std::shared_ptr<gSparse::Util::MappedFile> & file, const gSparse::Util::BinaryGraphHeader & header) :
+            UndirectedGraph(
+                gSparse::EdgeList(reinterpret_cast<const gSparse::NodeIndex *>(file->data() + header.edgeOffset()),
+                    static_cast<Eigen::Index>(header.edgeCount), 2),
+                gSparse::WeightList(reinterpret_cast<const gSparse::PRECISION *>(file->data() + header.weightOffset()),
+                    static_cast<Eigen::Index>(header.edgeCount), 1)),
+            _file(file)
+        {
+            if ((header.flags & gSparse::Util::BinaryGraphHeader::LAPLACIAN) && header.nodeCount == _nodeCount)
+            {
+                gSparse::Util::readBinaryLaplacian(file->data(), header, _laplacianMatrix.matrix);
+                _laplacianMatrix.ready.store(true, std::memory_order_release);
+            }
+        }
+    private:
+        std::shared_ptr<gSparse::Util::MappedFile> _file;  //!< Keeps the lists mapped
+    };
+
+    //! A Graph Binary Data Reader
+    /*!
+        This class reads files written by gSparse::GraphBinaryWriter. The file is memory-mapped, so nothing is parsed:
+        Read copies the lists out of the mapping, and Load wraps them without copying.
+        Files written with another gSparse::NodeIndex or gSparse::PRECISION are converted on load.
+    */
+    class GraphBinaryReader : public IGraphReader
+    {
+    public:
+        // Disallow default constructor
+        GraphBinaryReader() = delete;
+        //! Constructor
+        /*!
+        \param FileName: A filename pointing to a binary graph file.
+        */
+        GraphBinaryReader(const std::string & FileName) : _file(FileName) {}
+        //! Read graph data from the file specified in the constructor
+        /*!
+        \param Edges: An Eigen Matrix to receive the Edge list.
+        \param Weights: An Eigen Matrix to receive the Weight list.
+        */
+        virtual void Read(gSparse::EdgeMatrix & Edges,
+            gSparse::PrecisionRowMatrix & Weights)
+        {
+            gSparse::Util::MappedFile file;
+            const gSparse::Util::BinaryGraphHeader header = _open(file);
+            _readLists(file.data(), header, Edges, Weights);
+        }
+        //! Read the Laplacian stored in the file. Returns false if the file has none.
+        /*!
+        \param Laplacian: A sparse matrix to receive the Laplacian.
+        */
+        inline bool ReadLaplacian(gSparse::SparsePrecisionMatrix & Laplacian)
+        {
+            gSparse::Util::MappedFile file;
+            const gSparse::Util::BinaryGraphHeader header = _open(file);
+            if (!(header.flags & gSparse::Util::BinaryGraphHeader::LAPLACIAN)) return false;
+            gSparse::Util::readBinaryLaplacian(file.data(), header, Laplacian);
+            return true;
+        }
+        //! Read the effective resistances stored in the file. Returns false if the file has none.
+        /*!
+        \param er: A row matrix to receive one effective resistance per edge.
+        */
+        inline bool ReadER(gSparse::PrecisionRowMatrix & er)
+        {
+            gSparse::Util::MappedFile file;
+            const gSparse::Util::BinaryGraphHeader header = _open(file);
+            if (!(header.flags & gSparse::Util::BinaryGraphHeader::ER)) return false;
+            er.resize(static_cast<Eigen::Index>(header.edgeCount), 1);
+            gSparse::Util::copyBinaryNumbers(file.data() + header.erOffset(), static_cast<std::size_t>(header.edgeCount),
+                header.scalarBytes, true, er.data());
+            return true;
+        }
+        //! Load the graph in the file specified in the constructor.
+        /*!
+            When the file matches gSparse::NodeIndex and gSparse::PRECISION, the graph is a MappedUndirectedGraph that
+            uses the mapped lists directly, so loading costs no more than mapping the file. Otherwise the lists are
+            converted into an UndirectedGraph.
+        */
+        inline gSparse::Graph Load()
+        {
+            std::shared_ptr<gSparse::Util::MappedFile> file = std::make_shared<gSparse::Util::MappedFile>();
+            const gSparse::Util::BinaryGraphHeader header = _open(*file);
+            if (header.indexBytes == sizeof(gSparse::NodeIndex) && header.scalarBytes == sizeof(gSparse::PRECISION))
+                return std::make_shared<MappedUndirectedGraph>(file, header);
+            gSparse::EdgeMatrix edges;
+            gSparse::PrecisionRowMatrix weights;
+            _readLists(file->data(), header, edges, weights);
+            return std::make_shared<gSparse::UndirectedGraph>(std::move(edges), std::move(weights));
+        }
+        //! Default destructor
+        virtual ~GraphBinaryReader() = default;
+    private:
+        std::string _file;  //!< File name
+
+        //! Map the file and validate its header
+        inline gSparse::Util::BinaryGraphHeader _open(gSparse::Util::MappedFile & file) const
+        {
+            if (!file.open(_file))
+            {
+                std::stringstream ss;
+                ss << "GraphBinaryReader: File Not Found: " << _file << std::endl;
+                throw std::runtime_error(ss.str());
+            }
+            gSparse::Util::BinaryGraphHeader header;
+            if (file.size() < sizeof(header))
+            {
+                std::stringstream ss;
+                ss << "GraphBinaryReader: Not a binary graph file: " << _file << std::endl;
+                throw std::runtime_error(ss.str());
+            }
+            std::memcpy(&header, file.data(), sizeof(header));
+            if (!header.valid() || file.size() < header.fileSize())
+            {
+                std::stringstream ss;
+                ss << "GraphBinaryReader: Not a binary graph file, or truncated: " << _file << std::endl;
+                throw std::runtime_error(ss.str());
+            }
+            return header;
+        }
+        //! Copy the edge and weight lists out of a mapped file
+        static inline void _readLists(const char * data, const gSparse::Util::BinaryGraphHeader & header,
+            gSparse::EdgeMatrix & Edges, gSparse::PrecisionRowMatrix & Weights)
+        {
+            const std::size_t m = static_cast<std::size_t>(header.edgeCount);
+            Edges.resize(static_cast<Eigen::Index>(m), 2);
+            Weights.resize(static_cast<Eigen::Index>(m), 1);
+            gSparse::Util::copyBinaryNumbers(data + header.edgeOffset(), m * 2, header.indexBytes, false, Edges.data());
+            gSparse::Util::copyBinaryNumbers(data + header.weightOffset(), m, header.scalarBytes, true, Weights.data());
+        }
+    };
+}
+#endif
@@ -0,0 +1,116 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_GRAPHBINARYSTREAMREADER_HPP
+#define GSPARSE_GRAPHBINARYSTREAMREADER_HPP
+
+#include <exception>  // Runtime_exception
+#include <sstream>    // Errror Message
+#include <string>
+#include <fstream>
+#include <vector>
+#include <cstddef>    // size_t
+#include <cstdint>
+#include <algorithm>  // std::min
+#include <limits>
+
+#include "Config.hpp" // Library configuration
+#include "Interface/GraphStreamReader.hpp"  // Baseclass definitions
+#include "Util/BinaryGraph.hpp"  // File layout
+
+namespace gSparse
+{
+    //! A Graph Binary Data Stream Reader
+    /*!
+        This class reads files written by gSparse::GraphBinaryWriter in batches of edges. Edge and weight sections
+        are read batch by batch through two file streams, so memory use does not depend on the size of the graph.
+        Files written with another gSparse::NodeIndex or gSparse::PRECISION are converted batch by batch.
+    */
+    class GraphBinaryStreamReader : public IGraphStreamReader
+    {
+    public:
+        // Disallow default constructor
+        GraphBinaryStreamReader() = delete;
+        //! Constructor
+        /*!
+        \param FileName: A filename pointing to a binary graph file.
+        */
+        GraphBinaryStreamReader(const std::string & FileName) :
+            _file(FileName),
+            _edges(FileName.c_str(), std::ios::binary),
+            _weights(FileName.c_str(), std::ios::binary)
+        {
+            if (!_edges.is_open() || !_weights.is_open()) _error("File Not Found");
+            _edges.read(reinterpret_cast<char *>(&_header), sizeof(_header));
+            if (!_edges || !_header.valid()) _error("Not a binary graph file");
+            _edges.seekg(0, std::ios::end);
+            if (static_cast<std::uint64_t>(_edges.tellg()) < _header.fileSize()) _error("Not a binary graph file, or truncated");
+            Reset();
+        }
+        //! Read the next batch of edges
+        /*!
+        \param Edges: An Eigen Matrix to receive the Edge list of the batch.
+        \param Weights: An Eigen Matrix to receive the Weight list of the batch.
+        \return false, with empty matrices, once every edge has been read.
+        */
+        virtual bool ReadBatch(gSparse::EdgeMatrix & Edges,
+            gSparse::PrecisionRowMatrix & Weights)
+        {
+            const std::size_t count = static_cast<std::size_t>(
+                std::min<std::uint64_t>(_batchSize, _header.edgeCount - _edgeRead));
+            Edges.resize(static_cast<Eigen::Index>(count), 2);
+            Weights.resize(static_cast<Eigen::Index>(count), 1);
+            if (count == 0) return false;
+            _readNumbers(_edges, 2 * count, _header.indexBytes, false, Edges.data());
+            _readNumbers(_weights, count, _header.scalarBytes, true, Weights.data());
+            _edgeRead += count;
+            return true;
+        }
+        //! Start reading again from the first edge
+        virtual void Reset()
+        {
+            _edges.clear();
+            _edges.seekg(static_cast<std::streamoff>(_header.edgeOffset()));
+            _weights.clear();
+            _weights.seekg(static_cast<std::streamoff>(_header.weightOffset()));
+            _edgeRead = 0;
+        }
+        //! Number of nodes stored in the file header
+        inline std::size_t GetNodeCount() const { return static_cast<std::size_t>(_header.nodeCount); }
+        //! Number of edges stored in the file header
+        inline std::size_t GetEdgeCount() const { return static_cast<std::size_t>(_header.edgeCount); }
+        //! Default destructor
+        virtual ~GraphBinaryStreamReader() = default;
+    private:
+        std::string _file;  //!< File name
+        std::ifstream _edges;  //!< Stream positioned in the edge section
+        std::ifstream _weights;  //!< Stream positioned in the weight section
+        gSparse::Util::BinaryGraphHeader _header;  //!< Validated file header
+        std::uint64_t _edgeRead = 0;  //!< Edges read since the last Reset
+        std::vector<char> _bytes;  //!< Stored numbers of a batch that need conversion
+
+        //! Read count stored numbers from a stream into out, converting them to T
+        template <typename T>
+        inline void _readNumbers(std::ifstream & in, std::size_t count, std::uint32_t bytes, bool real, T * out)
+        {
+            if (bytes == sizeof(T) && real == !std::numeric_limits<T>::is_integer)
+                in.read(reinterpret_cast<char *>(out), static_cast<std::streamsize>(count * sizeof(T)));
+            else
+            {
+                _bytes.resize(count * bytes);
+                in.read(_bytes.data(), static_cast<std::streamsize>(_bytes.size()));
+                gSparse::Util::copyBinaryNumbers(_bytes.data(), count, bytes, real, out);
+            }
+            if (!in) _error("Unable to read");
+        }
+        //! Throw a std::runtime_error naming the file
+        inline void _error(const std::string & message) const
+        {
+            std::stringstream ss;
+            ss << "GraphBinaryStreamReader: " << message << ": " << _file << std::endl;
+            throw std::runtime_error(ss.str());
+        }
+    };
+}
+#endif
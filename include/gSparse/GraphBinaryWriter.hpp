@@ -0,0 +1,164 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_GRAPHBINARYWRITER_HPP
+#define GSPARSE_GRAPHBINARYWRITER_HPP
+
+#include <exception>  // Runtime_exception
+#include <fstream>    // File IO
+#include <sstream>    // Errror Message
+#include <string>
+#include <cstddef>    // size_t
+#include <cstdint>
+
+#include <Eigen/Sparse>
+
+#include "Config.hpp" // Library configuration
+#include "Interface/GraphWriter.hpp"  // Baseclass definitions
+#include "Util/BinaryGraph.hpp"       // File layout
+
+namespace gSparse
+{
+    //! A Graph Binary Data Writer
+    /*!
+        This class writes a graph into a single binary file (see gSparse::Util::BinaryGraphHeader) that
+        gSparse::GraphBinaryReader maps back into memory without parsing.
+        The Laplacian and effective resistances of the graph can be stored alongside the edge and weight lists.
+    */
+    class GraphBinaryWriter : public IGraphWriter
+    {
+    public:
+        // Disallow default constructor
+        GraphBinaryWriter() = delete;
+        //! Constructor
+        /*!
+        \param FileName: A filename to write the graph to.
+        \param IncludeLaplacian: Whether Write(graph) also stores the Laplacian of the graph. Default is false.
+        */
+        GraphBinaryWriter(const std::string & FileName, bool IncludeLaplacian = false) :
+            _file(FileName),
+            _includeLaplacian(IncludeLaplacian)
+        {}
+        //! Set whether Write(graph) also stores the Laplacian of the graph
+        inline void SetIncludeLaplacian(bool includeLaplacian) { _includeLaplacian = includeLaplacian; }
+        //! Get whether Write(graph) also stores the Laplacian of the graph
+        inline bool GetIncludeLaplacian() const { return _includeLaplacian; }
+
+        //! Write a graph to the file specified in the constructor
+        /*!
+        \param graph: A graph object
+        */
+        virtual void inline Write(const gSparse::Graph & graph)
+        {
+            if (graph == nullptr)
+                throw std::invalid_argument("GraphBinaryWriter: graph must not be NULL");
+            _write(graph->GetEdgeList(), graph->GetWeightList(), graph->GetNodeCount(),
+                _includeLaplacian ? &graph->GetLaplacianMatrix() : nullptr, nullptr);
+        }
+        //! Write a graph and its effective resistances to the file specified in the constructor
+        /*!
+        \param graph: A graph object
+        \param er: Effective resistance of each edge of the graph, e.g. from gSparse::ER::ApproximateER
+        */
+        inline void Write(const gSparse::Graph & graph, const gSparse::PrecisionRowMatrix & er)
+        {
+            if (graph == nullptr)
+                throw std::invalid_argument("GraphBinaryWriter: graph must not be NULL");
+            if (static_cast<std::size_t>(er.size()) != graph->GetEdgeCount())
+                throw std::invalid_argument("GraphBinaryWriter: er must hold one value per edge");
+            _write(graph->GetEdgeList(), graph->GetWeightList(), graph->GetNodeCount(),
+                _includeLaplacian ? &graph->GetLaplacianMatrix() : nullptr, &er);
+        }
+        //! Write an edge list to the file specified in the constructor. Weights are one.
+        /*!
+        \param Edges: An edge list to be written
+        */
+        virtual void inline Write(const gSparse::EdgeMatrix & Edges)
+        {
+            const gSparse::PrecisionRowMatrix weights = gSparse::PrecisionRowMatrix::Ones(Edges.rows(), 1);
+            Write(Edges, weights);
+        }
+        //! Write edge and weight lists to the file specified in the constructor
+        /*!
+        \param Edges: An edge list to be written
+        \param Weights: A weight list to be written
+        */
+        virtual void inline Write(const gSparse::EdgeMatrix & Edges,
+            const gSparse::PrecisionRowMatrix & Weights)
+        {
+            if (Edges.cols() != 2 || Weights.rows() != Edges.rows() || Weights.cols() != 1)
+                throw std::invalid_argument("GraphBinaryWriter: Edges must be m x 2 and Weights m x 1");
+            const std::size_t nodeCount = Edges.rows() == 0 ? 0 :
+                static_cast<std::size_t>(Edges.maxCoeff()) + 1;
+            _write(gSparse::EdgeList(Edges.data(), Edges.rows(), 2), gSparse::WeightList(Weights.data(), Weights.rows(), 1),
+                nodeCount, nullptr, nullptr);
+        }
+        virtual ~GraphBinaryWriter() = default;
+    private:
+        std::string _file;          //!< File name
+        bool _includeLaplacian;     //!< Whether Write(graph) stores the Laplacian
+
+        //! Write one section, padded to its offset in the file
+        static inline void _section(std::ofstream & file, std::uint64_t offset, const void * data, std::uint64_t bytes)
+        {
+            static const char zeros[64] = {};
+            std::uint64_t position = static_cast<std::uint64_t>(file.tellp());
+            if (position < offset) file.write(zeros, static_cast<std::streamsize>(offset - position));
+            if (bytes != 0) file.write(static_cast<const char *>(data), static_cast<std::streamsize>(bytes));
+        }
+        //! Write the header and every section
+        inline void _write(const gSparse::EdgeList & edges, const gSparse::WeightList & weights, std::size_t nodeCount,
+            const gSparse::SparsePrecisionMatrix * laplacian, const gSparse::PrecisionRowMatrix * er)
+        {
+            typedef gSparse::SparsePrecisionMatrix::StorageIndex StorageIndex;
+            gSparse::SparsePrecisionMatrix compressed;
+            if (laplacian != nullptr && !laplacian->isCompressed())
+            {
+                compressed = *laplacian;
+                compressed.makeCompressed();
+                laplacian = &compressed;
+            }
+
+            Util::BinaryGraphHeader header = Util::BinaryGraphHeader::create(
+                sizeof(gSparse::NodeIndex), sizeof(gSparse::PRECISION), sizeof(StorageIndex));
+            header.nodeCount = nodeCount;
+            header.edgeCount = static_cast<std::uint64_t>(edges.rows());
+            if (laplacian != nullptr)
+            {
+                header.flags |= Util::BinaryGraphHeader::LAPLACIAN;
+                if (static_cast<std::size_t>(laplacian->outerSize()) != nodeCount ||
+                    static_cast<std::size_t>(laplacian->innerSize()) != nodeCount)
+                    throw std::invalid_argument("GraphBinaryWriter: Laplacian must be nodeCount x nodeCount");
+                header.laplacianNonZeros = static_cast<std::uint64_t>(laplacian->nonZeros());
+            }
+            if (er != nullptr) header.flags |= Util::BinaryGraphHeader::ER;
+
+            std::ofstream file(_file.c_str(), std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+            {
+                std::stringstream ss;
+                ss << "GraphBinaryWriter: File Not Found: " << _file << std::endl;
+                throw std::runtime_error(ss.str());
+            }
+            _section(file, 0, &header, sizeof(header));
+            _section(file, header.edgeOffset(), edges.data(), header.edgeCount * 2 * sizeof(gSparse::NodeIndex));
+            _section(file, header.weightOffset(), weights.data(), header.edgeCount * sizeof(gSparse::PRECISION));
+            if (laplacian != nullptr)
+            {
+                _section(file, header.outerOffset(), laplacian->outerIndexPtr(), (header.nodeCount + 1) * sizeof(StorageIndex));
+                _section(file, header.innerOffset(), laplacian->innerIndexPtr(), header.laplacianNonZeros * sizeof(StorageIndex));
+                _section(file, header.valueOffset(), laplacian->valuePtr(), header.laplacianNonZeros * sizeof(gSparse::PRECISION));
+            }
+            if (er != nullptr)
+                _section(file, header.erOffset(), er->data(), header.edgeCount * sizeof(gSparse::PRECISION));
+            if (!file)
+            {
+                std::stringstream ss;
+                ss << "GraphBinaryWriter: Unable to write " << _file << std::endl;
+                throw std::runtime_error(ss.str());
+            }
+        }
+    };
+}
+#endif
@@ -6,15 +6,19 @@
 #define GSPARSE_GRAPHCSVREADER_HPP
 
 #include <exception>  // Runtime_exception
-#include <fstream>    // File IO
 #include <sstream>    // Errror Message
-#include <vector>     // load_csv
-#include <string>     // Getline
+#include <string>     // File names
 #include <cstddef>    // size_t
+#include <vector>     // Chunk bookkeeping
+#include <algorithm>  // std::copy
+#include <cstring>    // memchr
 #include <utility>    // std::move
 
 #include "Config.hpp" // Library configuration
 #include "Interface/GraphReader.hpp"  // Baseclass definitions
+#include "Util/MappedFile.hpp"  // Memory-mapped input
+#include "Util/CSVParser.hpp"   // Number parsing
+#include "Util/Parallel.hpp"    // Parsing chunks concurrently
 
 namespace gSparse
 {
@@ -36,6 +40,8 @@ namespace gSparse
             _delim = csvReader._delim;
             _edgeFile = csvReader._edgeFile;
             _weightFile = csvReader._weightFile;
+            _threadCount = csvReader._threadCount;
+            _minChunkBytes = csvReader._minChunkBytes;
         }
         //! A = operator overloaded
         GraphCSVReader& operator=(const GraphCSVReader & csvReader) noexcept
@@ -43,6 +49,8 @@ namespace gSparse
             _delim = csvReader._delim;
             _edgeFile = csvReader._edgeFile;
             _weightFile = csvReader._weightFile;
+            _threadCount = csvReader._threadCount;
+            _minChunkBytes = csvReader._minChunkBytes;
             return *this;
         }
         //! Constructor
@@ -76,50 +84,121 @@ namespace gSparse
 				Weights = gSparse::PrecisionRowMatrix::Ones(Edges.rows(), 1);
 		}
 
+        //! Set number of threads parsing a file.
+        /*!
+            A file is split into one newline-aligned chunk per thread. Files smaller than two chunks are read by one thread.
+        \param threadCount: Number of threads. Default is 0, which uses every hardware thread.
+        \param minChunkBytes: Smallest chunk parsed by a thread. Default is 1 MiB.
+        */
+        inline void SetThreadCount(std::size_t threadCount, std::size_t minChunkBytes = 1 << 20)
+        {
+            _threadCount = threadCount;
+            _minChunkBytes = minChunkBytes > 0 ? minChunkBytes : 1;
+        }
+        //! Get number of threads parsing a file. Zero means every hardware thread.
+        inline std::size_t GetThreadCount() const { return _threadCount; }
+
         //! Default destructor
 		~GraphCSVReader() = default;
 	private:
 		char _delim;  //!< CSV file delimeter
 		std::string  _edgeFile;  //!< Edge file name
 		std::string  _weightFile;  //!< Weight file name
+		std::size_t _threadCount = 0;  //!< Number of parsing threads. Zero means every hardware thread.
+		std::size_t _minChunkBytes = 1 << 20;  //!< Smallest piece of a file parsed by one thread
         //! Template function that load CSV data into Eigen Matrix
         /*!
+            The file is memory-mapped and split into newline-aligned chunks that are parsed concurrently. The matrix is
+            sized from the number of lines, and cells are parsed straight into its row-major storage. Blank lines are skipped.
         \param path: path to filename.
         */
 		template<typename M>
 		void load_csv(const std::string & path, M & matrix)
 		{
-            // Allocate input file stream
-			std::ifstream indata;
-			indata.open(path);
+            static_assert(M::IsRowMajor, "GraphCSVReader: load_csv writes rows contiguously");
+            typedef typename M::Scalar Scalar;
 
             // Unable to open the file, throw exceptions
-			if (!indata.is_open())
+			gSparse::Util::MappedFile file;
+			if (!file.open(path))
 			{
 				std::stringstream ss;
 				ss << "GraphCSVReader: File Not Found: " << path << std::endl;
 				throw std::runtime_error(ss.str());
 			}
+            const char * begin = file.data();
+            const char * end = file.end();
 
-			std::string line;  // variable to hold each line
-			std::vector<typename M::Scalar> values;  // final value
-			std::size_t rows = 0;   // row counter
+            // Number of columns is the number of cells in the first non-blank line
+            long cols = gSparse::Util::countCSVColumns<Scalar>(begin, end, _delim);
+            if (cols < 0)
+            {
+                std::stringstream ss;
+                ss << "GraphCSVReader: Malformed first row in " << path << std::endl;
+                throw std::runtime_error(ss.str());
+            }
+            if (cols == 0)
+            {
+                matrix.resize(0, 0);
+                return;
+            }
 
-            // Read each line and add the data into vector . O(rc) complexity. r = rows. c = columns.
-			while (std::getline(indata, line))
-			{
-				std::stringstream lineStream(line);
-				std::string cell;
-				while (std::getline(lineStream, cell, _delim))
-				{
-					values.push_back(static_cast<typename M::Scalar>(std::stod(cell)));
-				}
-				++rows;
-			}
-            // Close file
-			indata.close();
-            // Map STL vector to Eigen Matrix
-			matrix = Eigen::Map<const Eigen::Matrix<typename M::Scalar, M::RowsAtCompileTime, M::ColsAtCompileTime, Eigen::RowMajor>>(values.data(), rows, values.size() / rows);
+            // Split the file into newline-aligned chunks of at least _minChunkBytes, one per thread
+            std::size_t chunkCount = gSparse::Util::resolveThreadCount(_threadCount);
+            const std::size_t bytes = static_cast<std::size_t>(end - begin);
+            if (chunkCount > bytes / _minChunkBytes) chunkCount = bytes / _minChunkBytes;
+            if (chunkCount < 1) chunkCount = 1;
+            std::vector<const char *> bounds(1, begin);
+            for (std::size_t c = 1; c < chunkCount; ++c)
+            {
+                const char * cut = begin + bytes / chunkCount * c;
+                if (cut < bounds.back()) continue;
+                const void * newline = std::memchr(cut, '\n', static_cast<std::size_t>(end - cut));
+                if (newline == nullptr) break;
+                bounds.push_back(static_cast<const char *>(newline) + 1);
+            }
+            bounds.push_back(end);
+            chunkCount = bounds.size() - 1;
+
+            // Every line holds at most one row, so a prefix sum over line counts places each chunk in the matrix
+            std::vector<std::size_t> offsets(chunkCount + 1, 0);
+            gSparse::Util::parallelFor(0, chunkCount, chunkCount, [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t c = first; c != last; ++c)
+                    offsets[c + 1] = gSparse::Util::countLines(bounds[c], bounds[c + 1]);
+            });
+            for (std::size_t c = 0; c != chunkCount; ++c) offsets[c + 1] += offsets[c];
+            matrix.resize(static_cast<Eigen::Index>(offsets.back()), static_cast<Eigen::Index>(cols));
+
+            // Parse chunks concurrently, each straight into its own rows of the matrix. O(rc) complexity.
+            std::vector<std::size_t> rows(chunkCount, 0);
+            std::vector<const char *> errors(chunkCount, nullptr);
+            Scalar * data = matrix.data();
+            const std::size_t width = static_cast<std::size_t>(cols);
+            gSparse::Util::parallelFor(0, chunkCount, chunkCount, [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t c = first; c != last; ++c)
+                    rows[c] = gSparse::Util::parseCSVRows(bounds[c], bounds[c + 1], _delim, width,
+                        data + offsets[c] * width, offsets[c + 1] - offsets[c], errors[c]);
+            });
+
+            // Blank lines leave gaps at the end of chunks. Close them with a prefix sum over row counts.
+            std::size_t total = 0;
+            for (std::size_t c = 0; c != chunkCount; ++c)
+            {
+                if (errors[c] != nullptr)
+                {
+                    std::stringstream ss;
+                    ss << "GraphCSVReader: Malformed row " << total + rows[c] + 1 << " in " << path << ": expected " << cols
+                       << " numbers" << std::endl;
+                    throw std::runtime_error(ss.str());
+                }
+                if (total != offsets[c])
+                    std::copy(data + offsets[c] * width, data + (offsets[c] + rows[c]) * width, data + total * width);
+                total += rows[c];
+            }
+            if (total != offsets.back())
+                matrix.conservativeResize(static_cast<Eigen::Index>(total), static_cast<Eigen::Index>(cols));
 		}
 	}; 
 }
@@ -0,0 +1,146 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_GRAPHCSVSTREAMREADER_HPP
+#define GSPARSE_GRAPHCSVSTREAMREADER_HPP
+
+#include <exception>  // Runtime_exception
+#include <sstream>    // Errror Message
+#include <string>     // File names
+#include <cstddef>    // size_t
+#include <memory>     // unique_ptr
+
+#include "Config.hpp" // Library configuration
+#include "Interface/GraphStreamReader.hpp"  // Baseclass definitions
+#include "Util/LineReader.hpp"  // Block-wise input
+#include "Util/CSVParser.hpp"   // Number parsing
+
+namespace gSparse
+{
+    //! A Graph CSV Data Stream Reader
+    /*!
+        This class reads the same Edge and Weight CSV files as gSparse::GraphCSVReader, in batches of edges.
+        Both files are read through fixed-size blocks, so memory use does not depend on the size of the graph.
+        Node index starts from zero. Weight data type is gSparse::PRECISION type defined in Config.hpp
+    */
+    class GraphCSVStreamReader : public IGraphStreamReader
+    {
+    public:
+        // Disallow default constructor
+        GraphCSVStreamReader() = delete;
+        //! Constructor
+        /*!
+        \param EdgeFileName: A filename pointing to a CSV file that contains Edge list.
+        \param WeightFileName: A filename pointing to a CSV file that contains weight list. Default is "None": all weights equal to one.
+        \param delimeter: A delimeter of the CSV file. Default is a comma (,).
+        */
+        GraphCSVStreamReader(const std::string & EdgeFileName,
+            const std::string & WeightFileName = "None",
+            const std::string & delimeter = ","):
+            _delim(delimeter[0]),
+            _edgeFile(EdgeFileName),
+            _weightFile(WeightFileName),
+            _edges(_open(EdgeFileName))
+        {
+            if (_weightFile != "None") _weights = _open(_weightFile);
+        }
+        //! Read the next batch of edges
+        /*!
+        \param Edges: An Eigen Matrix to receive the Edge list of the batch.
+        \param Weights: An Eigen Matrix to receive the Weight list of the batch.
+        \return false, with empty matrices, once every edge has been read.
+        */
+        virtual bool ReadBatch(gSparse::EdgeMatrix & Edges,
+            gSparse::PrecisionRowMatrix & Weights)
+        {
+            Edges.resize(static_cast<Eigen::Index>(_batchSize), 2);
+            Weights.resize(static_cast<Eigen::Index>(_batchSize), 1);
+            std::size_t count = 0;
+            while (count != _batchSize && _nextRow(*_edges, _edgeFile, _edgeRow, 2, Edges.data() + 2 * count))
+            {
+                if (_weights)
+                {
+                    if (!_nextRow(*_weights, _weightFile, _weightRow, 1, Weights.data() + count))
+                        _error("Fewer weights than edges in " + _weightFile);
+                }
+                else
+                    Weights(count) = 1;
+                ++count;
+            }
+            if (count != _batchSize && _weights)
+            {
+                gSparse::PRECISION extra;
+                if (_nextRow(*_weights, _weightFile, _weightRow, 1, &extra))
+                    _error("More weights than edges in " + _weightFile);
+            }
+            if (count != _batchSize)
+            {
+                Edges.conservativeResize(static_cast<Eigen::Index>(count), 2);
+                Weights.conservativeResize(static_cast<Eigen::Index>(count), 1);
+            }
+            return count != 0;
+        }
+        //! Start reading again from the first edge
+        virtual void Reset()
+        {
+            _edges->rewind();
+            _edgeRow = 0;
+            if (_weights) _weights->rewind();
+            _weightRow = 0;
+        }
+        //! Default destructor
+        virtual ~GraphCSVStreamReader() = default;
+    private:
+        char _delim;  //!< CSV file delimeter
+        std::string _edgeFile;  //!< Edge file name
+        std::string _weightFile;  //!< Weight file name
+        std::unique_ptr<gSparse::Util::LineReader> _edges;  //!< Edge file input
+        std::unique_ptr<gSparse::Util::LineReader> _weights;  //!< Weight file input, or none for unit weights
+        std::size_t _edgeRow = 0;  //!< Rows read from the edge file
+        std::size_t _weightRow = 0;  //!< Rows read from the weight file
+
+        //! Open a file, or throw if it does not exist
+        static inline std::unique_ptr<gSparse::Util::LineReader> _open(const std::string & path)
+        {
+            std::unique_ptr<gSparse::Util::LineReader> reader(new gSparse::Util::LineReader(path));
+            if (!reader->is_open())
+            {
+                std::stringstream ss;
+                ss << "GraphCSVStreamReader: File Not Found: " << path << std::endl;
+                throw std::runtime_error(ss.str());
+            }
+            return reader;
+        }
+        //! Parse the next non-blank line of a file into cols cells. Returns false at the end of the file.
+        template <typename Scalar>
+        inline bool _nextRow(gSparse::Util::LineReader & reader, const std::string & path, std::size_t & row,
+            std::size_t cols, Scalar * out)
+        {
+            const char * begin;
+            const char * end;
+            while (reader.next(begin, end))
+            {
+                long count = gSparse::Util::parseCSVRow(begin, end, _delim, out, cols);
+                if (count == 0) continue;
+                ++row;
+                if (count != static_cast<long>(cols))
+                {
+                    std::stringstream ss;
+                    ss << "Malformed row " << row << " in " << path << ": expected " << cols << " numbers";
+                    _error(ss.str());
+                }
+                return true;
+            }
+            return false;
+        }
+        //! Throw a std::runtime_error
+        static inline void _error(const std::string & message)
+        {
+            std::stringstream ss;
+            ss << "GraphCSVStreamReader: " << message << std::endl;
+            throw std::runtime_error(ss.str());
+        }
+    };
+}
+#endif
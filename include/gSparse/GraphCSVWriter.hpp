@@ -8,13 +8,14 @@
 #include <exception>  // Runtime_exception
 #include <fstream>    // File IO
 #include <sstream>    // Errror Message
-#include <vector>     // load_csv
-#include <string>     // Getline
+#include <string>
 #include <cstddef>    // size_t
+#include <cstring>    // memcpy
 #include <utility>    // std::move
 
 #include "Config.hpp" // Library configuration
 #include "Interface/GraphWriter.hpp"  // Baseclass definitions
+#include "Util/BufferedWriter.hpp"    // Buffered output
 
 namespace gSparse
 {
@@ -35,6 +36,7 @@ namespace gSparse
             _delim = csvReader._delim;
             _edgeFile = csvReader._edgeFile;
             _weightFile = csvReader._weightFile;
+            _background = csvReader._background;
         }
         //! A = operator overloaded
         GraphCSVWriter& operator=(const GraphCSVWriter & csvReader) noexcept
@@ -42,6 +44,7 @@ namespace gSparse
             _delim = csvReader._delim;
             _edgeFile = csvReader._edgeFile;
             _weightFile = csvReader._weightFile;
+            _background = csvReader._background;
             return *this;
         }
         //! Constructor
@@ -74,9 +77,9 @@ namespace gSparse
 				throw std::invalid_argument("GraphCSVWriter: Unable to write weight without destination filename");
             }
             // Write the Edge List
-			write_csv<gSparse::EdgeMatrix>(_edgeFile, graph->GetEdgeList());
+			write_csv(_edgeFile, graph->GetEdgeList());
             // Write the Weight List
-			write_csv<gSparse::PrecisionRowMatrix>(_weightFile, graph->GetWeightList());
+			write_csv(_weightFile, graph->GetWeightList());
 		}
         //! Write graph data to a CSV file specified in the constructor
         /*!
@@ -102,32 +105,61 @@ namespace gSparse
             // Write Weight list
 			write_csv<gSparse::PrecisionRowMatrix>(_weightFile, Weights);
 		}
+        //! Set whether a background thread writes formatted data while the next part is formatted. Default is false.
+        inline void SetBackgroundWrite(bool background) { _background = background; }
+        //! Get whether a background thread writes formatted data
+        inline bool GetBackgroundWrite() const { return _background; }
 		virtual ~GraphCSVWriter() = default;
 	private:
 
 		std::string _delim;       //!< CSV file delimeter
 		std::string  _edgeFile;   //!< Edge file name
 		std::string  _weightFile; //!< Weight file name
+		bool _background = false; //!< Whether a thread writes full buffers while the next is formatted
 
         //! Template function to write Eigen Matrix into CSV file
         /*!
+            Rows are formatted with gSparse::Util::formatNumber into the buffers of a gSparse::Util::BufferedWriter.
         \param fileName: File name to write the data
         \param matrix: Eigen Matrix containing the data
         */
 		template <typename M>
 		void inline write_csv(const std::string & fileName, const M & matrix)
 		{
-			Eigen::IOFormat CSVFormat(Eigen::StreamPrecision, Eigen::DontAlignCols, _delim, "\n");
-			std::ofstream file(fileName.c_str());
+			gSparse::Util::BufferedWriter file(fileName, _background);
 			if (!file.is_open())
 			{
 				std::stringstream ss;
 				ss << "GraphCSVWriter: File Not Found: " << fileName << std::endl;
 				throw std::runtime_error(ss.str());
 			}
-			file << matrix.format(CSVFormat);
-            file << "\n";
-			file.close();
+            const Eigen::Index rows = matrix.rows();
+            const Eigen::Index cols = matrix.cols();
+            // A row never holds more than rowChars characters, so a row is formatted without bounds checks
+            const std::size_t rowChars = static_cast<std::size_t>(cols) * (gSparse::Util::MAX_NUMBER_CHARS + _delim.size()) + 1;
+            for (Eigen::Index i = 0; i != rows; ++i)
+            {
+                char * p = file.reserve(rowChars);
+                for (Eigen::Index j = 0; j != cols; ++j)
+                {
+                    if (j != 0)
+                    {
+                        std::memcpy(p, _delim.data(), _delim.size());
+                        p += _delim.size();
+                    }
+                    p += gSparse::Util::formatNumber(p, matrix(i, j));
+                }
+                *p++ = '\n';
+                file.commit(p);
+            }
+            // An empty matrix is written as an empty line
+            if (rows == 0) file.write("\n", 1);
+            if (!file.close())
+            {
+                std::stringstream ss;
+                ss << "GraphCSVWriter: Unable to write " << fileName << std::endl;
+                throw std::runtime_error(ss.str());
+            }
 		}
 	};
 }
@@ -0,0 +1,120 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_GRAPHMETISREADER_HPP
+#define GSPARSE_GRAPHMETISREADER_HPP
+
+#include <exception>  // Runtime_exception
+#include <sstream>    // Errror Message
+#include <string>
+#include <cstddef>    // size_t
+
+#include "Config.hpp" // Library configuration
+#include "Interface/GraphReader.hpp"  // Baseclass definitions
+#include "Util/MappedFile.hpp"  // Memory-mapped input
+#include "Util/CSVParser.hpp"   // Number parsing
+
+namespace gSparse
+{
+    //! A Graph METIS Adjacency Reader
+    /*!
+        This class reads graphs in the adjacency format of METIS and its partitioners. The header line gives the number
+        of vertices n, the number of edges m and an optional format: the last digit flags edge weights, the middle one
+        vertex weights and the first one vertex sizes. Line u of the n lines that follow lists the neighbours of vertex u,
+        each followed by the edge weight if the format has one. Lines starting with % are comments.
+        Vertices start from one and are shifted to start from zero. Each edge is listed by both of its ends and kept once,
+        and vertex weights and sizes are skipped.
+    */
+    class GraphMETISReader : public IGraphReader
+    {
+    public:
+        // Disallow default constructor
+        GraphMETISReader() = delete;
+        //! Constructor
+        /*!
+        \param FileName: A filename pointing to a METIS graph file.
+        */
+        GraphMETISReader(const std::string & FileName) : _file(FileName) {}
+        //! Read graph data from the file specified in the constructor
+        /*!
+        \param Edges: An Eigen Matrix to receive the Edge list.
+        \param Weights: An Eigen Matrix to receive the Weight list.
+        */
+        virtual void Read(gSparse::EdgeMatrix & Edges,
+            gSparse::PrecisionRowMatrix & Weights)
+        {
+            gSparse::Util::MappedFile file;
+            if (!file.open(_file)) _error("File Not Found", 0);
+            const char * cursor = file.data();
+            const char * end = file.end();
+
+            // n m [fmt [ncon]]
+            std::size_t n = 0, m = 0, format = 0, constraints = 1;
+            if (!gSparse::Util::nextDataLine(cursor, end, '%') ||
+                !gSparse::Util::readNumber(cursor, end, n) ||
+                !gSparse::Util::readNumber(cursor, end, m))
+                _error("Malformed header", 0);
+            if (!gSparse::Util::atLineEnd(cursor, end) && !gSparse::Util::readNumber(cursor, end, format))
+                _error("Malformed header", 0);
+            if (!gSparse::Util::atLineEnd(cursor, end) && !gSparse::Util::readNumber(cursor, end, constraints))
+                _error("Malformed header", 0);
+            if (!gSparse::Util::atLineEnd(cursor, end) || format % 10 > 1 || format / 10 % 10 > 1 || format > 111)
+                _error("Malformed header", 0);
+            gSparse::Util::skipLine(cursor, end);
+            const bool edgeWeights = format % 10 == 1;
+            const std::size_t skipped = (format / 100 == 1 ? 1 : 0) + (format / 10 % 10 == 1 ? constraints : 0);
+
+            // Vertex lines, where blank lines are vertices without neighbours
+            Edges.resize(static_cast<Eigen::Index>(m), 2);
+            Weights.resize(static_cast<Eigen::Index>(m), 1);
+            std::size_t edgeCount = 0;
+            for (std::size_t u = 1; u <= n; ++u)
+            {
+                while (cursor != end && *cursor == '%') gSparse::Util::skipLine(cursor, end);
+                for (std::size_t k = 0; k != skipped; ++k)
+                {
+                    gSparse::PRECISION ignored;
+                    if (!gSparse::Util::readNumber(cursor, end, ignored)) _error("Malformed vertex weight", u);
+                }
+                while (!gSparse::Util::atLineEnd(cursor, end))
+                {
+                    std::size_t v = 0;
+                    gSparse::PRECISION weight = 1;
+                    if (!gSparse::Util::readNumber(cursor, end, v) || v < 1 || v > n ||
+                        (edgeWeights && !gSparse::Util::readNumber(cursor, end, weight)))
+                        _error("Malformed neighbour", u);
+                    // Keep each edge from its smaller end
+                    if (v <= u) continue;
+                    if (edgeCount == m) _error("More edges than the header declares", u);
+                    Edges(edgeCount, 0) = static_cast<gSparse::NodeIndex>(u - 1);
+                    Edges(edgeCount, 1) = static_cast<gSparse::NodeIndex>(v - 1);
+                    Weights(edgeCount) = weight;
+                    ++edgeCount;
+                }
+                gSparse::Util::skipLine(cursor, end);
+            }
+            if (gSparse::Util::nextDataLine(cursor, end, '%')) _error("More vertex lines than the header declares", 0);
+            if (edgeCount != m)
+            {
+                Edges.conservativeResize(static_cast<Eigen::Index>(edgeCount), 2);
+                Weights.conservativeResize(static_cast<Eigen::Index>(edgeCount), 1);
+            }
+        }
+        //! Default destructor
+        virtual ~GraphMETISReader() = default;
+    private:
+        std::string _file;  //!< File name
+
+        //! Throw a std::runtime_error naming the file and the vertex
+        inline void _error(const std::string & message, std::size_t vertex) const
+        {
+            std::stringstream ss;
+            ss << "GraphMETISReader: " << message;
+            if (vertex != 0) ss << " at vertex " << vertex;
+            ss << ": " << _file << std::endl;
+            throw std::runtime_error(ss.str());
+        }
+    };
+}
+#endif
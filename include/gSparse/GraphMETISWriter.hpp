@@ -0,0 +1,148 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_GRAPHMETISWRITER_HPP
+#define GSPARSE_GRAPHMETISWRITER_HPP
+
+#include <exception>  // Runtime_exception
+#include <sstream>    // Errror Message
+#include <string>
+#include <vector>
+#include <cstddef>    // size_t
+#include <cstdint>
+
+#include "Config.hpp" // Library configuration
+#include "Interface/GraphWriter.hpp"  // Baseclass definitions
+#include "Util/BufferedWriter.hpp"    // Buffered output
+
+namespace gSparse
+{
+    //! A Graph METIS Adjacency Writer
+    /*!
+        This class writes graphs in the adjacency format of METIS: a header with the number of vertices and edges, then
+        one line per vertex listing its neighbours from one, each followed by the edge weight unless only an edge list is
+        written. Self loops are left out, as the format has none.
+        METIS and its partitioners only accept integer weights, so weighted files are only usable there if every weight
+        is an integer.
+    */
+    class GraphMETISWriter : public IGraphWriter
+    {
+    public:
+        // Disallow default constructor
+        GraphMETISWriter() = delete;
+        //! Constructor
+        /*!
+        \param FileName: A filename to write the graph to.
+        */
+        GraphMETISWriter(const std::string & FileName) : _file(FileName) {}
+        //! Write a graph to the file specified in the constructor
+        /*!
+        \param graph: A graph object
+        */
+        virtual void inline Write(const gSparse::Graph & graph)
+        {
+            if (graph == nullptr)
+                throw std::invalid_argument("GraphMETISWriter: graph must not be NULL");
+            const gSparse::WeightList weights = graph->GetWeightList();
+            _write(graph->GetEdgeList(), &weights, graph->GetNodeCount());
+        }
+        //! Write an edge list to the file specified in the constructor, without weights
+        /*!
+        \param Edges: An edge list to be written
+        */
+        virtual void inline Write(const gSparse::EdgeMatrix & Edges)
+        {
+            _write(gSparse::EdgeList(Edges.data(), Edges.rows(), Edges.cols()), nullptr, _nodeCount(Edges));
+        }
+        //! Write edge and weight lists to the file specified in the constructor
+        /*!
+        \param Edges: An edge list to be written
+        \param Weights: A weight list to be written
+        */
+        virtual void inline Write(const gSparse::EdgeMatrix & Edges,
+            const gSparse::PrecisionRowMatrix & Weights)
+        {
+            if (Weights.rows() != Edges.rows())
+                throw std::invalid_argument("GraphMETISWriter: Edges and Weights must have the same number of rows");
+            const gSparse::WeightList weights(Weights.data(), Weights.rows(), 1);
+            _write(gSparse::EdgeList(Edges.data(), Edges.rows(), Edges.cols()), &weights, _nodeCount(Edges));
+        }
+        virtual ~GraphMETISWriter() = default;
+    private:
+        std::string _file;  //!< File name
+
+        //! Number of nodes of an edge list
+        static inline std::size_t _nodeCount(const gSparse::EdgeMatrix & Edges)
+        {
+            return Edges.size() == 0 ? 0 : static_cast<std::size_t>(Edges.maxCoeff()) + 1;
+        }
+        //! Gather the neighbours of every vertex and write one line per vertex
+        inline void _write(const gSparse::EdgeList & edges, const gSparse::WeightList * weights, std::size_t nodeCount)
+        {
+            if (edges.cols() != 2)
+                throw std::invalid_argument("GraphMETISWriter: Edges.cols() must equal to two");
+
+            // Counting sort of the edge ends by vertex
+            std::vector<std::size_t> offsets(nodeCount + 1, 0);
+            std::size_t edgeCount = 0;
+            for (Eigen::Index i = 0; i != edges.rows(); ++i)
+            {
+                if (edges(i, 0) == edges(i, 1)) continue;
+                ++offsets[edges(i, 0) + 1];
+                ++offsets[edges(i, 1) + 1];
+                ++edgeCount;
+            }
+            for (std::size_t u = 0; u != nodeCount; ++u) offsets[u + 1] += offsets[u];
+            std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+            std::vector<gSparse::NodeIndex> neighbours(2 * edgeCount);
+            std::vector<Eigen::Index> edgeOf(weights != nullptr ? 2 * edgeCount : 0);
+            for (Eigen::Index i = 0; i != edges.rows(); ++i)
+            {
+                const gSparse::NodeIndex u = edges(i, 0), v = edges(i, 1);
+                if (u == v) continue;
+                if (weights != nullptr)
+                {
+                    edgeOf[next[u]] = i;
+                    edgeOf[next[v]] = i;
+                }
+                neighbours[next[u]++] = v;
+                neighbours[next[v]++] = u;
+            }
+
+            gSparse::Util::BufferedWriter file(_file);
+            if (!file.is_open())
+            {
+                std::stringstream ss;
+                ss << "GraphMETISWriter: File Not Found: " << _file << std::endl;
+                throw std::runtime_error(ss.str());
+            }
+            std::stringstream header;
+            header << nodeCount << " " << edgeCount << (weights != nullptr ? " 1\n" : "\n");
+            file.write(header.str());
+            for (std::size_t u = 0; u != nodeCount; ++u)
+            {
+                for (std::size_t k = offsets[u]; k != offsets[u + 1]; ++k)
+                {
+                    char * p = file.reserve(2 * gSparse::Util::MAX_NUMBER_CHARS + 2);
+                    if (k != offsets[u]) *p++ = ' ';
+                    p += gSparse::Util::formatNumber(p, neighbours[k] + std::uint64_t(1));
+                    if (weights != nullptr)
+                    {
+                        *p++ = ' ';
+                        p += gSparse::Util::formatNumber(p, (*weights)(edgeOf[k]));
+                    }
+                    file.commit(p);
+                }
+                file.write("\n", 1);
+            }
+            if (!file.close())
+            {
+                std::stringstream ss;
+                ss << "GraphMETISWriter: Unable to write " << _file << std::endl;
+                throw std::runtime_error(ss.str());
+            }
+        }
+    };
+}
+#endif
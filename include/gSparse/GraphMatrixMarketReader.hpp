@@ -0,0 +1,124 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_GRAPHMATRIXMARKETREADER_HPP
+#define GSPARSE_GRAPHMATRIXMARKETREADER_HPP
+
+#include <exception>  // Runtime_exception
+#include <sstream>    // Errror Message
+#include <string>
+#include <cstddef>    // size_t
+#include <cctype>     // tolower
+
+#include "Config.hpp" // Library configuration
+#include "Interface/GraphReader.hpp"  // Baseclass definitions
+#include "Util/MappedFile.hpp"  // Memory-mapped input
+#include "Util/CSVParser.hpp"   // Number parsing
+
+namespace gSparse
+{
+    //! A Graph Matrix Market Data Reader
+    /*!
+        This class reads the adjacency matrix of a graph from a Matrix Market coordinate file with symmetric
+        symmetry, such as the files of the SuiteSparse Matrix Collection. Each off-diagonal entry (i, j) is an edge
+        with the entry as its weight. Diagonal entries are ignored. Pattern files have unit weights.
+        Matrix Market indices start from one and are shifted to start from zero.
+    */
+    class GraphMatrixMarketReader : public IGraphReader
+    {
+    public:
+        // Disallow default constructor
+        GraphMatrixMarketReader() = delete;
+        //! Constructor
+        /*!
+        \param FileName: A filename pointing to a Matrix Market file.
+        */
+        GraphMatrixMarketReader(const std::string & FileName) : _file(FileName) {}
+        //! Read graph data from the file specified in the constructor
+        /*!
+        \param Edges: An Eigen Matrix to receive the Edge list.
+        \param Weights: An Eigen Matrix to receive the Weight list.
+        */
+        virtual void Read(gSparse::EdgeMatrix & Edges,
+            gSparse::PrecisionRowMatrix & Weights)
+        {
+            gSparse::Util::MappedFile file;
+            if (!file.open(_file)) _error("File Not Found");
+            const char * cursor = file.data();
+            const char * end = file.end();
+
+            // %%MatrixMarket matrix coordinate <field> symmetric
+            const char * bannerEnd = cursor;
+            gSparse::Util::skipLine(bannerEnd, end);
+            std::string banner(cursor, bannerEnd);
+            for (char & c : banner) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            std::stringstream words(banner);
+            std::string magic, object, format, field, symmetry;
+            words >> magic >> object >> format >> field >> symmetry;
+            if (magic != "%%matrixmarket" || object != "matrix" || format != "coordinate")
+                _error("Not a Matrix Market coordinate file");
+            if (field != "real" && field != "integer" && field != "pattern")
+                _error("Unsupported field " + field);
+            if (symmetry != "symmetric")
+                _error("Unsupported symmetry " + symmetry + ", only symmetric matrices describe undirected graphs");
+            const bool pattern = field == "pattern";
+            cursor = bannerEnd;
+
+            // rows cols entries
+            std::size_t rows = 0, cols = 0, entries = 0;
+            if (!gSparse::Util::nextDataLine(cursor, end, '%') ||
+                !gSparse::Util::readNumber(cursor, end, rows) ||
+                !gSparse::Util::readNumber(cursor, end, cols) ||
+                !gSparse::Util::readNumber(cursor, end, entries) ||
+                !gSparse::Util::atLineEnd(cursor, end))
+                _error("Malformed size line");
+            if (rows != cols) _error("Matrix is not square");
+
+            // The size line gives the number of entries, so lists are written in place
+            Edges.resize(static_cast<Eigen::Index>(entries), 2);
+            Weights.resize(static_cast<Eigen::Index>(entries), 1);
+            std::size_t edgeCount = 0;
+            for (std::size_t k = 0; k != entries; ++k)
+            {
+                gSparse::NodeIndex i = 0, j = 0;
+                gSparse::PRECISION weight = 1;
+                if (!gSparse::Util::nextDataLine(cursor, end, '%')) _error("File ends before every entry is read");
+                if (!gSparse::Util::readNumber(cursor, end, i) ||
+                    !gSparse::Util::readNumber(cursor, end, j) ||
+                    (!pattern && !gSparse::Util::readNumber(cursor, end, weight)) ||
+                    !gSparse::Util::atLineEnd(cursor, end) ||
+                    i < 1 || j < 1 || i > rows || j > rows)
+                {
+                    std::stringstream ss;
+                    ss << "Malformed entry " << k + 1;
+                    _error(ss.str());
+                }
+                gSparse::Util::skipLine(cursor, end);
+                if (i == j) continue;
+                Edges(edgeCount, 0) = i - 1;
+                Edges(edgeCount, 1) = j - 1;
+                Weights(edgeCount) = weight;
+                ++edgeCount;
+            }
+            if (edgeCount != entries)
+            {
+                Edges.conservativeResize(static_cast<Eigen::Index>(edgeCount), 2);
+                Weights.conservativeResize(static_cast<Eigen::Index>(edgeCount), 1);
+            }
+        }
+        //! Default destructor
+        virtual ~GraphMatrixMarketReader() = default;
+    private:
+        std::string _file;  //!< File name
+
+        //! Throw a std::runtime_error naming the file
+        inline void _error(const std::string & message) const
+        {
+            std::stringstream ss;
+            ss << "GraphMatrixMarketReader: " << message << ": " << _file << std::endl;
+            throw std::runtime_error(ss.str());
+        }
+    };
+}
+#endif
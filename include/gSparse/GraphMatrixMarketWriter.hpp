@@ -0,0 +1,119 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_GRAPHMATRIXMARKETWRITER_HPP
+#define GSPARSE_GRAPHMATRIXMARKETWRITER_HPP
+
+#include <exception>  // Runtime_exception
+#include <sstream>    // Errror Message
+#include <string>
+#include <cstddef>    // size_t
+#include <cstdint>
+#include <algorithm>  // std::min, std::max
+
+#include "Config.hpp" // Library configuration
+#include "Interface/GraphWriter.hpp"  // Baseclass definitions
+#include "Util/BufferedWriter.hpp"    // Buffered output
+
+namespace gSparse
+{
+    //! A Graph Matrix Market Data Writer
+    /*!
+        This class writes the adjacency matrix of a graph as a symmetric Matrix Market coordinate file. Each edge is
+        one entry of the lower triangle, with indices starting from one. Edge lists without weights are written
+        with the pattern field.
+    */
+    class GraphMatrixMarketWriter : public IGraphWriter
+    {
+    public:
+        // Disallow default constructor
+        GraphMatrixMarketWriter() = delete;
+        //! Constructor
+        /*!
+        \param FileName: A filename to write the graph to.
+        */
+        GraphMatrixMarketWriter(const std::string & FileName) : _file(FileName) {}
+        //! Write a graph to the file specified in the constructor
+        /*!
+        \param graph: A graph object
+        */
+        virtual void inline Write(const gSparse::Graph & graph)
+        {
+            if (graph == nullptr)
+                throw std::invalid_argument("GraphMatrixMarketWriter: graph must not be NULL");
+            const gSparse::WeightList weights = graph->GetWeightList();
+            _write(graph->GetEdgeList(), &weights, graph->GetNodeCount());
+        }
+        //! Write an edge list to the file specified in the constructor, as a pattern matrix
+        /*!
+        \param Edges: An edge list to be written
+        */
+        virtual void inline Write(const gSparse::EdgeMatrix & Edges)
+        {
+            _write(gSparse::EdgeList(Edges.data(), Edges.rows(), Edges.cols()), nullptr, _nodeCount(Edges));
+        }
+        //! Write edge and weight lists to the file specified in the constructor
+        /*!
+        \param Edges: An edge list to be written
+        \param Weights: A weight list to be written
+        */
+        virtual void inline Write(const gSparse::EdgeMatrix & Edges,
+            const gSparse::PrecisionRowMatrix & Weights)
+        {
+            if (Weights.rows() != Edges.rows())
+                throw std::invalid_argument("GraphMatrixMarketWriter: Edges and Weights must have the same number of rows");
+            const gSparse::WeightList weights(Weights.data(), Weights.rows(), 1);
+            _write(gSparse::EdgeList(Edges.data(), Edges.rows(), Edges.cols()), &weights, _nodeCount(Edges));
+        }
+        virtual ~GraphMatrixMarketWriter() = default;
+    private:
+        std::string _file;  //!< File name
+
+        //! Number of nodes of an edge list
+        static inline std::size_t _nodeCount(const gSparse::EdgeMatrix & Edges)
+        {
+            return Edges.size() == 0 ? 0 : static_cast<std::size_t>(Edges.maxCoeff()) + 1;
+        }
+        //! Write the banner, the size line and one entry per edge
+        inline void _write(const gSparse::EdgeList & edges, const gSparse::WeightList * weights, std::size_t nodeCount)
+        {
+            if (edges.cols() != 2)
+                throw std::invalid_argument("GraphMatrixMarketWriter: Edges.cols() must equal to two");
+            gSparse::Util::BufferedWriter file(_file);
+            if (!file.is_open())
+            {
+                std::stringstream ss;
+                ss << "GraphMatrixMarketWriter: File Not Found: " << _file << std::endl;
+                throw std::runtime_error(ss.str());
+            }
+            file.write(weights != nullptr ? "%%MatrixMarket matrix coordinate real symmetric\n"
+                                          : "%%MatrixMarket matrix coordinate pattern symmetric\n");
+            std::stringstream size;
+            size << nodeCount << " " << nodeCount << " " << edges.rows() << "\n";
+            file.write(size.str());
+            for (Eigen::Index i = 0; i != edges.rows(); ++i)
+            {
+                char * p = file.reserve(3 * gSparse::Util::MAX_NUMBER_CHARS + 3);
+                // Entries of the lower triangle
+                p += gSparse::Util::formatNumber(p, std::max(edges(i, 0), edges(i, 1)) + std::uint64_t(1));
+                *p++ = ' ';
+                p += gSparse::Util::formatNumber(p, std::min(edges(i, 0), edges(i, 1)) + std::uint64_t(1));
+                if (weights != nullptr)
+                {
+                    *p++ = ' ';
+                    p += gSparse::Util::formatNumber(p, (*weights)(i));
+                }
+                *p++ = '\n';
+                file.commit(p);
+            }
+            if (!file.close())
+            {
+                std::stringstream ss;
+                ss << "GraphMatrixMarketWriter: Unable to write " << _file << std::endl;
+                throw std::runtime_error(ss.str());
+            }
+        }
+    };
+}
+#endif
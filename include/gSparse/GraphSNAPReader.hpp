@@ -0,0 +1,94 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_GRAPHSNAPREADER_HPP
+#define GSPARSE_GRAPHSNAPREADER_HPP
+
+#include <exception>  // Runtime_exception
+#include <sstream>    // Errror Message
+#include <string>
+#include <cstddef>    // size_t
+
+#include "Config.hpp" // Library configuration
+#include "Interface/GraphReader.hpp"  // Baseclass definitions
+#include "Util/MappedFile.hpp"  // Memory-mapped input
+#include "Util/CSVParser.hpp"   // Number parsing
+
+namespace gSparse
+{
+    //! A Graph SNAP Edge List Reader
+    /*!
+        This class reads edge lists in the format of the Stanford Network Analysis Project: one edge per line as two
+        node indices separated by spaces or tabs, optionally followed by a weight. Lines starting with # are comments.
+        Either every edge has a weight or none has, in which case weights are one. Node indices are kept as they are.
+    */
+    class GraphSNAPReader : public IGraphReader
+    {
+    public:
+        // Disallow default constructor
+        GraphSNAPReader() = delete;
+        //! Constructor
+        /*!
+        \param FileName: A filename pointing to a SNAP edge list.
+        */
+        GraphSNAPReader(const std::string & FileName) : _file(FileName) {}
+        //! Read graph data from the file specified in the constructor
+        /*!
+        \param Edges: An Eigen Matrix to receive the Edge list.
+        \param Weights: An Eigen Matrix to receive the Weight list.
+        */
+        virtual void Read(gSparse::EdgeMatrix & Edges,
+            gSparse::PrecisionRowMatrix & Weights)
+        {
+            gSparse::Util::MappedFile file;
+            if (!file.open(_file)) _error("File Not Found", 0);
+            const char * cursor = file.data();
+            const char * end = file.end();
+
+            // Every line holds at most one edge
+            const std::size_t capacity = gSparse::Util::countLines(cursor, end);
+            Edges.resize(static_cast<Eigen::Index>(capacity), 2);
+            Weights.resize(static_cast<Eigen::Index>(capacity), 1);
+            std::size_t edgeCount = 0;
+            int weighted = -1;  // Unknown until the first edge
+            while (gSparse::Util::nextDataLine(cursor, end, '#'))
+            {
+                gSparse::NodeIndex u = 0, v = 0;
+                if (!gSparse::Util::readNumber(cursor, end, u) || !gSparse::Util::readNumber(cursor, end, v))
+                    _error("Malformed edge", edgeCount + 1);
+                if (weighted < 0) weighted = gSparse::Util::atLineEnd(cursor, end) ? 0 : 1;
+                gSparse::PRECISION weight = 1;
+                if (weighted == 1 && !gSparse::Util::readNumber(cursor, end, weight))
+                    _error("Malformed weight", edgeCount + 1);
+                if (!gSparse::Util::atLineEnd(cursor, end))
+                    _error(weighted ? "Too many columns" : "Edges have weights, but the first one has none", edgeCount + 1);
+                gSparse::Util::skipLine(cursor, end);
+                Edges(edgeCount, 0) = u;
+                Edges(edgeCount, 1) = v;
+                Weights(edgeCount) = weight;
+                ++edgeCount;
+            }
+            if (edgeCount != capacity)
+            {
+                Edges.conservativeResize(static_cast<Eigen::Index>(edgeCount), 2);
+                Weights.conservativeResize(static_cast<Eigen::Index>(edgeCount), 1);
+            }
+        }
+        //! Default destructor
+        virtual ~GraphSNAPReader() = default;
+    private:
+        std::string _file;  //!< File name
+
+        //! Throw a std::runtime_error naming the file and the edge
+        inline void _error(const std::string & message, std::size_t edge) const
+        {
+            std::stringstream ss;
+            ss << "GraphSNAPReader: " << message;
+            if (edge != 0) ss << " at edge " << edge;
+            ss << ": " << _file << std::endl;
+            throw std::runtime_error(ss.str());
+        }
+    };
+}
+#endif
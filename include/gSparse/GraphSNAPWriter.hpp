@@ -0,0 +1,114 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_GRAPHSNAPWRITER_HPP
+#define GSPARSE_GRAPHSNAPWRITER_HPP
+
+#include <exception>  // Runtime_exception
+#include <sstream>    // Errror Message
+#include <string>
+#include <cstddef>    // size_t
+
+#include "Config.hpp" // Library configuration
+#include "Interface/GraphWriter.hpp"  // Baseclass definitions
+#include "Util/BufferedWriter.hpp"    // Buffered output
+
+namespace gSparse
+{
+    //! A Graph SNAP Edge List Writer
+    /*!
+        This class writes edge lists in the format of the Stanford Network Analysis Project: a commented header, then
+        one tab-separated edge per line, followed by its weight unless only an edge list is written.
+    */
+    class GraphSNAPWriter : public IGraphWriter
+    {
+    public:
+        // Disallow default constructor
+        GraphSNAPWriter() = delete;
+        //! Constructor
+        /*!
+        \param FileName: A filename to write the graph to.
+        */
+        GraphSNAPWriter(const std::string & FileName) : _file(FileName) {}
+        //! Write a graph to the file specified in the constructor
+        /*!
+        \param graph: A graph object
+        */
+        virtual void inline Write(const gSparse::Graph & graph)
+        {
+            if (graph == nullptr)
+                throw std::invalid_argument("GraphSNAPWriter: graph must not be NULL");
+            const gSparse::WeightList weights = graph->GetWeightList();
+            _write(graph->GetEdgeList(), &weights, graph->GetNodeCount());
+        }
+        //! Write an edge list to the file specified in the constructor, without weights
+        /*!
+        \param Edges: An edge list to be written
+        */
+        virtual void inline Write(const gSparse::EdgeMatrix & Edges)
+        {
+            _write(gSparse::EdgeList(Edges.data(), Edges.rows(), Edges.cols()), nullptr, _nodeCount(Edges));
+        }
+        //! Write edge and weight lists to the file specified in the constructor
+        /*!
+        \param Edges: An edge list to be written
+        \param Weights: A weight list to be written
+        */
+        virtual void inline Write(const gSparse::EdgeMatrix & Edges,
+            const gSparse::PrecisionRowMatrix & Weights)
+        {
+            if (Weights.rows() != Edges.rows())
+                throw std::invalid_argument("GraphSNAPWriter: Edges and Weights must have the same number of rows");
+            const gSparse::WeightList weights(Weights.data(), Weights.rows(), 1);
+            _write(gSparse::EdgeList(Edges.data(), Edges.rows(), Edges.cols()), &weights, _nodeCount(Edges));
+        }
+        virtual ~GraphSNAPWriter() = default;
+    private:
+        std::string _file;  //!< File name
+
+        //! Number of nodes of an edge list
+        static inline std::size_t _nodeCount(const gSparse::EdgeMatrix & Edges)
+        {
+            return Edges.size() == 0 ? 0 : static_cast<std::size_t>(Edges.maxCoeff()) + 1;
+        }
+        //! Write the header and one line per edge
+        inline void _write(const gSparse::EdgeList & edges, const gSparse::WeightList * weights, std::size_t nodeCount)
+        {
+            if (edges.cols() != 2)
+                throw std::invalid_argument("GraphSNAPWriter: Edges.cols() must equal to two");
+            gSparse::Util::BufferedWriter file(_file);
+            if (!file.is_open())
+            {
+                std::stringstream ss;
+                ss << "GraphSNAPWriter: File Not Found: " << _file << std::endl;
+                throw std::runtime_error(ss.str());
+            }
+            std::stringstream header;
+            header << "# Undirected graph\n# Nodes: " << nodeCount << " Edges: " << edges.rows() << "\n"
+                   << (weights != nullptr ? "# FromNodeId\tToNodeId\tWeight\n" : "# FromNodeId\tToNodeId\n");
+            file.write(header.str());
+            for (Eigen::Index i = 0; i != edges.rows(); ++i)
+            {
+                char * p = file.reserve(3 * gSparse::Util::MAX_NUMBER_CHARS + 3);
+                p += gSparse::Util::formatNumber(p, edges(i, 0));
+                *p++ = '\t';
+                p += gSparse::Util::formatNumber(p, edges(i, 1));
+                if (weights != nullptr)
+                {
+                    *p++ = '\t';
+                    p += gSparse::Util::formatNumber(p, (*weights)(i));
+                }
+                *p++ = '\n';
+                file.commit(p);
+            }
+            if (!file.close())
+            {
+                std::stringstream ss;
+                ss << "GraphSNAPWriter: Unable to write " << _file << std::endl;
+                throw std::runtime_error(ss.str());
+            }
+        }
+    };
+}
+#endif
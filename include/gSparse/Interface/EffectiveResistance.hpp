@@ -6,6 +6,7 @@
 #define GSPARSE_INTERFACE_EFFECTIVERESISTANCE_HPP
 
 #include <memory>        //shared_ptr
+#include <cstdint>       //uint64_t
 #include "../Config.hpp" // Library configuration
 
 namespace gSparse
@@ -19,6 +20,8 @@ namespace gSparse
 	public:
         //! A pure virtual member to computer sparsifier weight.
 		virtual gSparse::COMPUTE_INFO CalculateER( gSparse::PrecisionRowMatrix &, const gSparse::Graph & ) = 0;
+        //! Set the seed of a randomized calculator. Deterministic calculators ignore it.
+		virtual void SetSeed(std::uint64_t) {}
 		virtual ~IEffectiveResistance() = default;
 	protected:
 		IEffectiveResistance() = default;
@@ -29,10 +29,10 @@ namespace gSparse
 		virtual const gSparse::SparsePrecisionMatrix & GetLaplacianMatrix() const = 0;
         //!  Pure virtual function to get Graph Weight Matrix
 		virtual const gSparse::SparsePrecisionMatrix & GetWeightMatrix() const = 0;
-        //!  Pure virtual function to get Graph Edge List Matrix
-		virtual const gSparse::EdgeMatrix & GetEdgeList() const = 0;
-        //!  Pure virtual function to get Graph Weight List Matrix
-		virtual const gSparse::PrecisionRowMatrix & GetWeightList() const = 0;
+        //!  Pure virtual function to get a view of Graph Edge List Matrix
+		virtual gSparse::EdgeList GetEdgeList() const = 0;
+        //!  Pure virtual function to get a view of Graph Weight List Matrix
+		virtual gSparse::WeightList GetWeightList() const = 0;
         //!  Pure virtual function to get number of edges in the graph
 		virtual std::size_t GetEdgeCount() const = 0;
         //!  Pure virtual function to get number of nodes in the graph
@@ -0,0 +1,66 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_INTERFACE_GRAPHSTREAMREADER_HPP
+#define GSPARSE_INTERFACE_GRAPHSTREAMREADER_HPP
+
+#include <cstddef>    // size_t
+#include <Eigen/Dense> // Eigen Matrix
+#include <memory>   //shared_ptr
+#include "../Config.hpp" // Library configuration
+
+namespace gSparse
+{
+    //!  An interface class for streamed Graph Input.
+    /*!
+        This class defines an interface for reading a graph as a sequence of edge batches, so graphs larger than memory
+        can be processed one batch at a time. Only one batch is held in memory.
+        New streamed input source should derive from this class.
+    */
+    class IGraphStreamReader
+    {
+    public:
+        //!  Default Constructor for IGraphStreamReader.
+        IGraphStreamReader() = default;
+        //! A pure virtual member to read the next batch of at most GetBatchSize() edges.
+        /*!
+        \param Edges: An Eigen Matrix to receive the Edge list of the batch.
+        \param Weights: An Eigen Matrix to receive the Weight list associated to the Edge list.
+        \return false, with empty matrices, once every edge has been read.
+        */
+        virtual bool ReadBatch(gSparse::EdgeMatrix & Edges,
+            gSparse::PrecisionRowMatrix & Weights) = 0;
+        //! A pure virtual member to start reading again from the first edge.
+        virtual void Reset() = 0;
+        //! Set the largest number of edges in a batch. Default is 65536.
+        inline void SetBatchSize(std::size_t batchSize) { _batchSize = batchSize > 0 ? batchSize : 1; }
+        //! Get the largest number of edges in a batch.
+        inline std::size_t GetBatchSize() const { return _batchSize; }
+        //! Read the whole input from the first edge, calling fn(Edges, Weights) on every batch.
+        /*!
+        \param fn: A callable taking (const gSparse::EdgeMatrix &, const gSparse::PrecisionRowMatrix &).
+        \return Number of edges read.
+        */
+        template <typename Function>
+        inline std::size_t ForEachBatch(Function fn)
+        {
+            Reset();
+            gSparse::EdgeMatrix Edges;
+            gSparse::PrecisionRowMatrix Weights;
+            std::size_t edgeCount = 0;
+            while (ReadBatch(Edges, Weights))
+            {
+                fn(static_cast<const gSparse::EdgeMatrix &>(Edges), static_cast<const gSparse::PrecisionRowMatrix &>(Weights));
+                edgeCount += static_cast<std::size_t>(Edges.rows());
+            }
+            return edgeCount;
+        }
+        //!  Default virtual destructor
+        virtual ~IGraphStreamReader() = default;
+    protected:
+        std::size_t _batchSize = 1 << 16;  //!< Largest number of edges in a batch
+    };
+    typedef std::shared_ptr<gSparse::IGraphStreamReader> GraphStreamReader;
+}
+#endif
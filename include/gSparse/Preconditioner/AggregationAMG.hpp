@@ -0,0 +1,227 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_PRECONDITIONER_AGGREGATIONAMG_HPP
+#define GSPARSE_PRECONDITIONER_AGGREGATIONAMG_HPP
+
+#include "../Config.hpp"
+#include "../Util/Laplacian.hpp"  // Grounded Laplacian
+
+#include <Eigen/Sparse>
+
+#include <vector>
+#include <cmath>
+
+namespace gSparse
+{
+    namespace Preconditioner
+    {
+        /// \ingroup Preconditioner
+        ///
+        /// Smoothed aggregation algebraic multigrid preconditioner for graph Laplacians.
+        /// Nodes are greedily grouped with their neighbors into aggregates, and the aggregates become
+        /// the nodes of the next coarser level. The tentative prolongator is smoothed by one damped Jacobi step.
+        /// The coarsest level is solved exactly. The preconditioner applies one symmetric V-cycle with
+        /// a forward Gauss-Seidel pre-smoother and a backward Gauss-Seidel post-smoother.
+        /// This class can be used as the Preconditioner of Eigen::ConjugateGradient.
+        ///
+        class AggregationAMG
+        {
+        public:
+            typedef gSparse::PRECISION Scalar;
+
+            //! Default constructor
+            AggregationAMG() : _info(Eigen::Success), _coarseSize(64), _maxLevels(20) {}
+            //! Construct and set up a preconditioner for a Laplacian
+            template <typename MatType>
+            explicit AggregationAMG(const MatType & mat) : _info(Eigen::Success), _coarseSize(64), _maxLevels(20) { compute(mat); }
+
+            /// Set the size below which a level is solved exactly. Default is 64 nodes.
+            inline void SetCoarseSize(std::size_t coarseSize) { _coarseSize = coarseSize; }
+            /// Get the size below which a level is solved exactly.
+            inline std::size_t GetCoarseSize() const { return _coarseSize; }
+            /// Set the maximum number of levels of the hierarchy. Default is 20.
+            inline void SetMaxLevels(std::size_t maxLevels) { _maxLevels = maxLevels > 0 ? maxLevels : 1; }
+            /// Get the maximum number of levels of the hierarchy.
+            inline std::size_t GetMaxLevels() const { return _maxLevels; }
+            /// Get the number of levels built by the last call to compute(), including the coarsest level.
+            inline std::size_t GetLevelCount() const { return _levels.size(); }
+
+            //! Pattern analysis is done as part of factorize()
+            template <typename MatType>
+            inline AggregationAMG & analyzePattern(const MatType &) { return *this; }
+            //! Build the multigrid hierarchy
+            template <typename MatType>
+            inline AggregationAMG & factorize(const MatType & mat)
+            {
+                _levels.clear();
+                _levels.push_back(_Level());
+                gSparse::Util::copyLaplacian(mat, _levels.back().A);
+                gSparse::Util::connectedComponents(_levels.back().A, _component);
+
+                while (_levels.size() < _maxLevels &&
+                    static_cast<std::size_t>(_levels.back().A.rows()) > _coarseSize)
+                {
+                    _Level & fine = _levels.back();
+                    fine.invDiag = _inverseDiagonal(fine.A);
+
+                    // Stop when aggregation no longer reduces the problem size
+                    gSparse::SparsePrecisionMatrix P;
+                    if (!_buildProlongator(fine.A, fine.invDiag, P))
+                        break;
+                    fine.P = P;
+                    fine.R = P.transpose();
+
+                    _Level coarse;
+                    coarse.A = fine.R * fine.A * fine.P;
+                    coarse.A.prune(static_cast<gSparse::PRECISION>(0));
+                    _levels.push_back(coarse);
+                }
+                _levels.back().invDiag = _inverseDiagonal(_levels.back().A);
+                _info = _coarseSolver.compute(_levels.back().A);
+                return *this;
+            }
+            //! Equivalent to analyzePattern() followed by factorize()
+            template <typename MatType>
+            inline AggregationAMG & compute(const MatType & mat) { return factorize(mat); }
+
+            //! Apply one V-cycle. Input and output are kept in the range of the Laplacian.
+            template <typename Rhs>
+            inline gSparse::PrecisionVector solve(const Eigen::MatrixBase<Rhs> & b) const
+            {
+                gSparse::PrecisionVector rhs = b;
+                gSparse::Util::removeComponentMean(rhs, _component);
+                gSparse::PrecisionVector x = _vcycle(0, rhs);
+                gSparse::Util::removeComponentMean(x, _component);
+                return x;
+            }
+
+            //! Return Eigen::Success if the hierarchy was built successfully
+            inline Eigen::ComputationInfo info() const { return _info; }
+        private:
+            //! One level of the multigrid hierarchy
+            struct _Level
+            {
+                gSparse::SparsePrecisionMatrix A;  //!< Operator of this level
+                gSparse::SparsePrecisionMatrix P;  //!< Prolongator from the next coarser level
+                gSparse::SparsePrecisionMatrix R;  //!< Restriction to the next coarser level
+                gSparse::PrecisionVector invDiag;  //!< Inverse of the diagonal of A
+            };
+
+            std::vector<_Level> _levels;  //!< Multigrid hierarchy. The last level is solved exactly.
+            std::vector<Eigen::Index> _component; //!< Connected component of each node of the finest level
+            gSparse::Util::GroundedSolver<Eigen::SimplicialLDLT<gSparse::SparsePrecisionMatrix>> _coarseSolver; //!< Coarsest level solver
+            Eigen::ComputationInfo _info; //!< Status of the setup
+            std::size_t _coarseSize;      //!< Size below which a level is solved exactly
+            std::size_t _maxLevels;       //!< Maximum number of levels
+
+            //! Inverse diagonal of a matrix. Zero diagonal entries (isolated nodes) map to zero.
+            static inline gSparse::PrecisionVector _inverseDiagonal(const gSparse::SparsePrecisionMatrix & A)
+            {
+                gSparse::PrecisionVector d = A.diagonal();
+                for (Eigen::Index i = 0; i != d.size(); ++i)
+                    d(i) = d(i) > 0 ? 1.0 / d(i) : 0.0;
+                return d;
+            }
+
+            //! Greedy aggregation followed by one damped Jacobi smoothing step of the tentative prolongator
+            static inline bool _buildProlongator(const gSparse::SparsePrecisionMatrix & A,
+                const gSparse::PrecisionVector & invDiag,
+                gSparse::SparsePrecisionMatrix & P)
+            {
+                const Eigen::Index n = A.cols();
+                std::vector<Eigen::Index> aggregate(n, -1);
+                Eigen::Index aggregateCount = 0;
+
+                // Pass 1: a node whose neighbors are all free starts a new aggregate with them
+                for (Eigen::Index i = 0; i != n; ++i)
+                {
+                    if (aggregate[i] >= 0) continue;
+                    bool free = true;
+                    for (gSparse::SparsePrecisionMatrix::InnerIterator it(A, i); it; ++it)
+                    {
+                        if (it.row() != i && aggregate[it.row()] >= 0) { free = false; break; }
+                    }
+                    if (!free) continue;
+                    aggregate[i] = aggregateCount;
+                    for (gSparse::SparsePrecisionMatrix::InnerIterator it(A, i); it; ++it)
+                        aggregate[it.row()] = aggregateCount;
+                    ++aggregateCount;
+                }
+                // Pass 2: remaining nodes join the aggregate of their strongest neighbor
+                for (Eigen::Index i = 0; i != n; ++i)
+                {
+                    if (aggregate[i] >= 0) continue;
+                    gSparse::PRECISION strongest = 0;
+                    for (gSparse::SparsePrecisionMatrix::InnerIterator it(A, i); it; ++it)
+                    {
+                        if (it.row() != i && aggregate[it.row()] >= 0 && -it.value() > strongest)
+                        {
+                            strongest = -it.value();
+                            aggregate[i] = aggregate[it.row()];
+                        }
+                    }
+                    if (aggregate[i] < 0) aggregate[i] = aggregateCount++;
+                }
+                if (aggregateCount == 0 || static_cast<double>(aggregateCount) > 0.9 * static_cast<double>(n))
+                    return false;
+
+                // Tentative prolongator: piecewise constant on aggregates
+                std::vector<Eigen::Triplet<gSparse::PRECISION>> entries;
+                entries.reserve(static_cast<std::size_t>(n));
+                for (Eigen::Index i = 0; i != n; ++i)
+                    entries.push_back(Eigen::Triplet<gSparse::PRECISION>(i, aggregate[i], 1.0));
+                gSparse::SparsePrecisionMatrix tentative(n, aggregateCount);
+                tentative.setFromTriplets(entries.begin(), entries.end());
+
+                // P = (I - omega * D^-1 * A) * tentative. The spectral radius of D^-1 A is at most 2 for Laplacians.
+                const gSparse::PRECISION omega = 2.0 / 3.0;
+                gSparse::SparsePrecisionMatrix DinvA = invDiag.asDiagonal() * A;
+                P = tentative - omega * (DinvA * tentative);
+                P.prune(static_cast<gSparse::PRECISION>(0));
+                return true;
+            }
+
+            //! Symmetric Gauss-Seidel sweep. A is symmetric, so column i holds row i.
+            static inline void _gaussSeidel(const gSparse::SparsePrecisionMatrix & A,
+                const gSparse::PrecisionVector & invDiag,
+                const gSparse::PrecisionVector & b,
+                gSparse::PrecisionVector & x,
+                bool forward)
+            {
+                const Eigen::Index n = A.cols();
+                for (Eigen::Index k = 0; k != n; ++k)
+                {
+                    const Eigen::Index i = forward ? k : n - 1 - k;
+                    if (invDiag(i) == 0) continue;
+                    gSparse::PRECISION sum = b(i);
+                    for (gSparse::SparsePrecisionMatrix::InnerIterator it(A, i); it; ++it)
+                    {
+                        if (it.row() != i) sum -= it.value() * x(it.row());
+                    }
+                    x(i) = sum * invDiag(i);
+                }
+            }
+
+            //! V-cycle starting at the given level
+            template <typename Rhs>
+            inline gSparse::PrecisionVector _vcycle(std::size_t level, const Eigen::MatrixBase<Rhs> & b) const
+            {
+                if (level + 1 == _levels.size())
+                    return _coarseSolver.solve(b);
+
+                const _Level & current = _levels[level];
+                const gSparse::PrecisionVector rhs = b;
+                gSparse::PrecisionVector x = gSparse::PrecisionVector::Zero(rhs.size());
+                _gaussSeidel(current.A, current.invDiag, rhs, x, true);
+                gSparse::PrecisionVector residual = rhs - current.A * x;
+                gSparse::PrecisionVector coarseRhs = current.R * residual;
+                x += current.P * _vcycle(level + 1, coarseRhs);
+                _gaussSeidel(current.A, current.invDiag, rhs, x, false);
+                return x;
+            }
+        };
+    }
+}
+#endif
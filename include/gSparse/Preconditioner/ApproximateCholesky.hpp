@@ -0,0 +1,227 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_PRECONDITIONER_APPROXIMATECHOLESKY_HPP
+#define GSPARSE_PRECONDITIONER_APPROXIMATECHOLESKY_HPP
+
+#include "../Config.hpp"
+#include "../Util/Laplacian.hpp"  // Connected components
+#include "../Util/Random.hpp"     // Counter-based random numbers
+
+#include <Eigen/Sparse>
+
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+
+namespace gSparse
+{
+    namespace Preconditioner
+    {
+        /// \ingroup Preconditioner
+        ///
+        /// Randomized approximate Cholesky preconditioner for graph Laplacians.
+        /// Adaptation of Kyng and Sachdeva, Approximate Gaussian Elimination for Laplacians <https://arxiv.org/abs/1605.02353>,
+        /// following the approxChol solver of Laplacians.jl.
+        /// Eliminating a node turns its neighborhood into a clique. Instead, the clique is replaced by a sparse random sample
+        /// of it with the same expectation, so the factor has about as many entries as the graph.
+        /// Nodes are eliminated in order of their current degree.
+        /// This class can be used as the Preconditioner of Eigen::ConjugateGradient.
+        ///
+        class ApproximateCholesky
+        {
+        public:
+            typedef gSparse::PRECISION Scalar;
+
+            //! Default constructor
+            ApproximateCholesky() : _info(Eigen::Success), _seed(gSparse::Util::nextSeed()) {}
+            //! Construct and factorize a preconditioner for a Laplacian
+            template <typename MatType>
+            explicit ApproximateCholesky(const MatType & mat) : _info(Eigen::Success), _seed(gSparse::Util::nextSeed()) { compute(mat); }
+
+            /// Set the seed of the random sampling. The factorization is deterministic for a given seed.
+            /// Default is gSparse::Util::nextSeed().
+            inline void SetSeed(std::uint64_t seed) { _seed = seed; }
+            /// Get the seed of the random sampling.
+            inline std::uint64_t GetSeed() const { return _seed; }
+            /// Get the number of off-diagonal entries of the factor.
+            inline std::size_t GetFactorSize() const { return _row.size(); }
+
+            //! Pattern analysis is done as part of factorize()
+            template <typename MatType>
+            inline ApproximateCholesky & analyzePattern(const MatType &) { return *this; }
+            //! Compute the approximate factorization
+            template <typename MatType>
+            inline ApproximateCholesky & factorize(const MatType & mat)
+            {
+                const Eigen::Index n = mat.cols();
+                gSparse::Util::connectedComponents(mat, _component);
+
+                // Adjacency lists from the off-diagonal entries of the Laplacian.
+                // Entries to eliminated nodes are left in place and skipped when a list is read.
+                std::vector<std::vector<_Entry>> adjacency(n);
+                for (Eigen::Index j = 0; j != mat.outerSize(); ++j)
+                {
+                    for (typename MatType::InnerIterator it(mat, j); it; ++it)
+                    {
+                        if (it.row() != it.col() && it.value() < 0)
+                            adjacency[it.col()].push_back(_Entry{ it.row(), -it.value() });
+                    }
+                }
+
+                // Nodes are picked by the length of their adjacency list. Stale heap items are skipped.
+                typedef std::pair<std::size_t, Eigen::Index> _Item;
+                std::priority_queue<_Item, std::vector<_Item>, std::greater<_Item>> queue;
+                for (Eigen::Index i = 0; i != n; ++i) queue.push(_Item(adjacency[i].size(), i));
+
+                std::vector<bool> eliminated(n, false);
+                std::vector<_Entry> column;
+                std::vector<gSparse::PRECISION> cumulative;
+                std::uint64_t counter = 0;
+
+                _pivot.clear();
+                _start.assign(1, 0);
+                _row.clear();
+                _fraction.clear();
+                _diagonal = gSparse::PrecisionVector::Zero(n);
+
+                while (!queue.empty())
+                {
+                    _Item item = queue.top();
+                    queue.pop();
+                    const Eigen::Index i = item.second;
+                    if (eliminated[i] || item.first != adjacency[i].size()) continue;
+                    eliminated[i] = true;
+
+                    // Live neighbors of i with parallel edges merged, sorted by increasing weight
+                    column.clear();
+                    for (const _Entry & e : adjacency[i])
+                        if (!eliminated[e.node]) column.push_back(e);
+                    std::vector<_Entry>().swap(adjacency[i]);
+                    std::sort(column.begin(), column.end(),
+                        [](const _Entry & a, const _Entry & b) { return a.node < b.node; });
+                    std::size_t len = 0;
+                    for (std::size_t k = 0; k != column.size(); ++k)
+                    {
+                        if (len > 0 && column[len - 1].node == column[k].node)
+                            column[len - 1].weight += column[k].weight;
+                        else
+                            column[len++] = column[k];
+                    }
+                    column.resize(len);
+                    // The last node of a component has no live neighbor. It keeps a zero pivot.
+                    if (len == 0) continue;
+                    std::sort(column.begin(), column.end(),
+                        [](const _Entry & a, const _Entry & b) { return a.weight < b.weight; });
+
+                    cumulative.resize(len);
+                    gSparse::PRECISION sum = 0;
+                    for (std::size_t k = 0; k != len; ++k)
+                    {
+                        sum += column[k].weight;
+                        cumulative[k] = sum;
+                    }
+
+                    // Each neighbor j is joined to one heavier neighbor k, sampled proportionally to weight.
+                    // The sampled edges equal the clique of the exact elimination in expectation.
+                    _pivot.push_back(i);
+                    gSparse::PRECISION degree = sum;
+                    gSparse::PRECISION scale = 1;
+                    for (std::size_t jj = 0; jj + 1 < len; ++jj)
+                    {
+                        const Eigen::Index j = column[jj].node;
+                        const gSparse::PRECISION f = column[jj].weight * scale / degree;
+                        const gSparse::PRECISION r = cumulative[jj] +
+                            gSparse::Util::toUniform(gSparse::Util::counterHash(_seed, counter++)) * (sum - cumulative[jj]);
+                        std::size_t kk = static_cast<std::size_t>(
+                            std::lower_bound(cumulative.begin() + jj + 1, cumulative.end(), r) - cumulative.begin());
+                        if (kk >= len) kk = len - 1;
+                        const Eigen::Index k = column[kk].node;
+
+                        const gSparse::PRECISION weight = f * (1 - f) * degree;
+                        adjacency[j].push_back(_Entry{ k, weight });
+                        adjacency[k].push_back(_Entry{ j, weight });
+                        queue.push(_Item(adjacency[j].size(), j));
+                        queue.push(_Item(adjacency[k].size(), k));
+
+                        _row.push_back(j);
+                        _fraction.push_back(f);
+                        scale *= 1 - f;
+                        degree *= (1 - f) * (1 - f);
+                    }
+                    _row.push_back(column[len - 1].node);
+                    _fraction.push_back(1);
+                    _start.push_back(static_cast<Eigen::Index>(_row.size()));
+                    _diagonal(i) = column[len - 1].weight * scale;
+                }
+                _info = Eigen::Success;
+                return *this;
+            }
+            //! Equivalent to analyzePattern() followed by factorize()
+            template <typename MatType>
+            inline ApproximateCholesky & compute(const MatType & mat) { return factorize(mat); }
+
+            //! Apply the preconditioner. Input and output are kept in the range of the Laplacian.
+            template <typename Rhs>
+            inline gSparse::PrecisionVector solve(const Eigen::MatrixBase<Rhs> & b) const
+            {
+                gSparse::PrecisionVector y = b;
+                gSparse::Util::removeComponentMean(y, _component);
+
+                // Forward substitution
+                for (std::size_t c = 0; c != _pivot.size(); ++c)
+                {
+                    const Eigen::Index i = _pivot[c];
+                    const Eigen::Index last = _start[c + 1] - 1;
+                    gSparse::PRECISION yi = y(i);
+                    for (Eigen::Index jj = _start[c]; jj != last; ++jj)
+                    {
+                        y(_row[jj]) += _fraction[jj] * yi;
+                        yi *= 1 - _fraction[jj];
+                    }
+                    y(_row[last]) += yi;
+                    y(i) = yi;
+                }
+                // Diagonal
+                for (Eigen::Index i = 0; i != y.size(); ++i)
+                    y(i) = _diagonal(i) != 0 ? y(i) / _diagonal(i) : 0;
+                // Backward substitution
+                for (std::size_t c = _pivot.size(); c-- != 0;)
+                {
+                    const Eigen::Index i = _pivot[c];
+                    const Eigen::Index last = _start[c + 1] - 1;
+                    gSparse::PRECISION yi = y(i) + y(_row[last]);
+                    for (Eigen::Index jj = last; jj-- != _start[c];)
+                        yi = (1 - _fraction[jj]) * yi + _fraction[jj] * y(_row[jj]);
+                    y(i) = yi;
+                }
+
+                gSparse::Util::removeComponentMean(y, _component);
+                return y;
+            }
+
+            //! Return Eigen::Success if the factorization succeeded
+            inline Eigen::ComputationInfo info() const { return _info; }
+        private:
+            //! Weighted entry of an adjacency list
+            struct _Entry
+            {
+                Eigen::Index node;
+                gSparse::PRECISION weight;
+            };
+
+            std::vector<Eigen::Index> _pivot;         //!< Eliminated nodes in elimination order
+            std::vector<Eigen::Index> _start;         //!< Start of the factor column of each eliminated node
+            std::vector<Eigen::Index> _row;           //!< Neighbor of each factor entry
+            std::vector<gSparse::PRECISION> _fraction; //!< Fraction of the remaining weight of each factor entry
+            gSparse::PrecisionVector _diagonal;       //!< Pivot of each node, zero for the last node of a component
+            std::vector<Eigen::Index> _component;     //!< Connected component of each node
+            Eigen::ComputationInfo _info;             //!< Status of the factorization
+            std::uint64_t _seed;                      //!< Seed of the random sampling
+        };
+    }
+}
+#endif
@@ -0,0 +1,63 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_PRECONDITIONER_INCOMPLETECHOLESKY_HPP
+#define GSPARSE_PRECONDITIONER_INCOMPLETECHOLESKY_HPP
+
+#include "../Config.hpp"
+#include "../Util/Laplacian.hpp"  // Grounded Laplacian
+
+#include <Eigen/Sparse>
+#include <Eigen/IterativeLinearSolvers>
+
+namespace gSparse
+{
+    namespace Preconditioner
+    {
+        /// \ingroup Preconditioner
+        ///
+        /// Incomplete Cholesky preconditioner for graph Laplacians.
+        /// A Laplacian is singular, so one node per connected component is grounded first and
+        /// Eigen::IncompleteCholesky is applied to the remaining positive definite system.
+        /// This class can be used as the Preconditioner of Eigen::ConjugateGradient.
+        ///
+        class IncompleteCholesky
+        {
+        public:
+            typedef gSparse::PRECISION Scalar;
+            typedef Eigen::IncompleteCholesky<gSparse::PRECISION, Eigen::Lower, Eigen::AMDOrdering<int>> FactorizationType;
+
+            //! Default constructor
+            IncompleteCholesky() : _info(Eigen::Success) {}
+            //! Construct and factorize a preconditioner for a Laplacian
+            template <typename MatType>
+            explicit IncompleteCholesky(const MatType & mat) : _info(Eigen::Success) { compute(mat); }
+
+            //! Pattern analysis is done as part of factorize()
+            template <typename MatType>
+            inline IncompleteCholesky & analyzePattern(const MatType &) { return *this; }
+            //! Ground the Laplacian and compute its incomplete Cholesky factorization
+            template <typename MatType>
+            inline IncompleteCholesky & factorize(const MatType & mat)
+            {
+                _info = _solver.compute(mat);
+                return *this;
+            }
+            //! Equivalent to analyzePattern() followed by factorize()
+            template <typename MatType>
+            inline IncompleteCholesky & compute(const MatType & mat) { return factorize(mat); }
+
+            //! Apply the preconditioner. Input and output are kept in the range of the Laplacian.
+            template <typename Rhs>
+            inline gSparse::PrecisionVector solve(const Eigen::MatrixBase<Rhs> & b) const { return _solver.projectedSolve(b); }
+
+            //! Return Eigen::Success if the factorization succeeded
+            inline Eigen::ComputationInfo info() const { return _info; }
+        private:
+            gSparse::Util::GroundedSolver<FactorizationType> _solver;  //!< Factorization of the grounded Laplacian
+            Eigen::ComputationInfo _info;                               //!< Status of the factorization
+        };
+    }
+}
+#endif
@@ -0,0 +1,66 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_PRECONDITIONER_SHAREDPRECONDITIONER_HPP
+#define GSPARSE_PRECONDITIONER_SHAREDPRECONDITIONER_HPP
+
+#include <Eigen/Core>
+
+#include <utility>  // std::declval
+#include <cassert>
+
+namespace gSparse
+{
+    namespace Preconditioner
+    {
+        /// \ingroup Preconditioner
+        ///
+        /// A read-only view of a preconditioner computed elsewhere.
+        /// Eigen::ConjugateGradient owns its preconditioner and computes it in compute(). With SharedPreconditioner
+        /// as its Preconditioner, compute() only binds the solver to the matrix, so solvers on several threads can
+        /// share one preconditioner that was computed once. The shared preconditioner must outlive the view.
+        ///
+        template <typename Preconditioner_>
+        class SharedPreconditioner
+        {
+        public:
+            //! Default constructor. Share() must be called before the view is used.
+            SharedPreconditioner() : _preconditioner(nullptr), _info(Eigen::InvalidInput) {}
+
+            /// Share a computed preconditioner. Its status is read here, as info() of some Eigen preconditioners is not const.
+            inline void Share(Preconditioner_ & preconditioner)
+            {
+                _preconditioner = &preconditioner;
+                _info = preconditioner.info();
+            }
+
+            //! The shared preconditioner is already computed
+            template <typename MatType>
+            inline SharedPreconditioner & analyzePattern(const MatType &) { return *this; }
+            //! The shared preconditioner is already computed
+            template <typename MatType>
+            inline SharedPreconditioner & factorize(const MatType &) { return *this; }
+            //! The shared preconditioner is already computed
+            template <typename MatType>
+            inline SharedPreconditioner & compute(const MatType &) { return *this; }
+
+            //! Apply the shared preconditioner
+            template <typename Rhs>
+            inline auto solve(const Rhs & b) const -> decltype(std::declval<const Preconditioner_ &>().solve(b))
+            {
+                #ifndef NDEBUG
+                    assert(_preconditioner != nullptr);
+                #endif
+                return _preconditioner->solve(b);
+            }
+
+            //! Return the status of the shared preconditioner
+            inline Eigen::ComputationInfo info() const { return _info; }
+        private:
+            const Preconditioner_ * _preconditioner;  //!< Computed preconditioner, owned elsewhere
+            Eigen::ComputationInfo _info;             //!< Status of the shared preconditioner
+        };
+    }
+}
+#endif
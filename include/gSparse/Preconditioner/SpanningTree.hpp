@@ -0,0 +1,244 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_PRECONDITIONER_SPANNINGTREE_HPP
+#define GSPARSE_PRECONDITIONER_SPANNINGTREE_HPP
+
+#include "../Config.hpp"
+#include "../Util/Laplacian.hpp"  // Grounded Laplacian
+
+#include <Eigen/Sparse>
+
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace gSparse
+{
+    namespace Preconditioner
+    {
+        /// \ingroup Preconditioner
+        ///
+        /// Augmented spanning tree preconditioner for graph Laplacians.
+        /// The preconditioner is the Laplacian of a maximum weight spanning forest of the graph,
+        /// augmented with the off-tree edges of highest stretch. The stretch of an edge (u, v) is its weight
+        /// times the resistance of the tree path between u and v. The augmented tree is sparse enough to be
+        /// factorized exactly, and a plain tree is factorized without fill.
+        /// This class can be used as the Preconditioner of Eigen::ConjugateGradient.
+        ///
+        class SpanningTree
+        {
+        public:
+            typedef gSparse::PRECISION Scalar;
+
+            //! Default constructor
+            SpanningTree() : _info(Eigen::Success), _augmentRatio(0.1) {}
+            //! Construct and factorize a preconditioner for a Laplacian
+            template <typename MatType>
+            explicit SpanningTree(const MatType & mat) : _info(Eigen::Success), _augmentRatio(0.1) { compute(mat); }
+
+            /// Set the number of off-tree edges added to the tree, as a fraction of the node count.
+            /// \param ratio Non-negative fraction. Zero yields a plain spanning tree. Default is 0.1.
+            inline void SetAugmentRatio(double ratio)
+            {
+                #ifndef NDEBUG
+                    assert(ratio >= 0.0);
+                #endif
+                _augmentRatio = ratio;
+            }
+            /// Get the number of off-tree edges added to the tree, as a fraction of the node count.
+            inline double GetAugmentRatio() const { return _augmentRatio; }
+
+            //! Pattern analysis is done as part of factorize()
+            template <typename MatType>
+            inline SpanningTree & analyzePattern(const MatType &) { return *this; }
+            //! Build the augmented spanning tree and factorize its Laplacian
+            template <typename MatType>
+            inline SpanningTree & factorize(const MatType & mat)
+            {
+                const Eigen::Index n = mat.cols();
+
+                // Collect edges from the off-diagonal entries of the Laplacian
+                std::vector<_Edge> edges;
+                edges.reserve(static_cast<std::size_t>(mat.nonZeros()) / 2);
+                for (Eigen::Index j = 0; j != mat.outerSize(); ++j)
+                {
+                    for (typename MatType::InnerIterator it(mat, j); it; ++it)
+                    {
+                        if (it.row() < it.col() && it.value() < 0)
+                            edges.push_back(_Edge{ it.row(), it.col(), -it.value() });
+                    }
+                }
+
+                // Kruskal's algorithm on decreasing weights yields a maximum weight spanning forest
+                std::sort(edges.begin(), edges.end(),
+                    [](const _Edge & a, const _Edge & b) { return a.weight > b.weight; });
+                std::vector<Eigen::Index> parent(n);
+                for (Eigen::Index i = 0; i != n; ++i) parent[i] = i;
+                auto findRoot = [&parent](Eigen::Index x)
+                {
+                    while (parent[x] != x)
+                    {
+                        parent[x] = parent[parent[x]];
+                        x = parent[x];
+                    }
+                    return x;
+                };
+                std::vector<_Edge> treeEdges;
+                std::vector<_Edge> offTreeEdges;
+                treeEdges.reserve(static_cast<std::size_t>(n));
+                for (const _Edge & e : edges)
+                {
+                    Eigen::Index a = findRoot(e.u);
+                    Eigen::Index b = findRoot(e.v);
+                    if (a != b)
+                    {
+                        parent[a] = b;
+                        treeEdges.push_back(e);
+                    }
+                    else
+                        offTreeEdges.push_back(e);
+                }
+
+                // Keep the off-tree edges of highest stretch
+                std::size_t augmentCount = std::min(offTreeEdges.size(),
+                    static_cast<std::size_t>(std::ceil(_augmentRatio * static_cast<double>(n))));
+                if (augmentCount > 0)
+                {
+                    _computeStretch(n, treeEdges, offTreeEdges);
+                    std::nth_element(offTreeEdges.begin(), offTreeEdges.begin() + (augmentCount - 1), offTreeEdges.end(),
+                        [](const _Edge & a, const _Edge & b) { return a.stretch > b.stretch; });
+                    treeEdges.insert(treeEdges.end(), offTreeEdges.begin(), offTreeEdges.begin() + augmentCount);
+                }
+
+                // Factorize the Laplacian of the augmented tree
+                std::vector<Eigen::Triplet<gSparse::PRECISION>> entries;
+                entries.reserve(treeEdges.size() * 4);
+                for (const _Edge & e : treeEdges)
+                {
+                    entries.push_back(Eigen::Triplet<gSparse::PRECISION>(e.u, e.u, e.weight));
+                    entries.push_back(Eigen::Triplet<gSparse::PRECISION>(e.v, e.v, e.weight));
+                    entries.push_back(Eigen::Triplet<gSparse::PRECISION>(e.u, e.v, -e.weight));
+                    entries.push_back(Eigen::Triplet<gSparse::PRECISION>(e.v, e.u, -e.weight));
+                }
+                gSparse::SparsePrecisionMatrix treeLaplacian(n, n);
+                treeLaplacian.setFromTriplets(entries.begin(), entries.end());
+                _info = _solver.compute(treeLaplacian);
+                return *this;
+            }
+            //! Equivalent to analyzePattern() followed by factorize()
+            template <typename MatType>
+            inline SpanningTree & compute(const MatType & mat) { return factorize(mat); }
+
+            //! Apply the preconditioner. Input and output are kept in the range of the Laplacian.
+            template <typename Rhs>
+            inline gSparse::PrecisionVector solve(const Eigen::MatrixBase<Rhs> & b) const { return _solver.projectedSolve(b); }
+
+            //! Return Eigen::Success if the factorization succeeded
+            inline Eigen::ComputationInfo info() const { return _info; }
+        private:
+            //! Weighted edge of the graph
+            struct _Edge
+            {
+                Eigen::Index u;
+                Eigen::Index v;
+                gSparse::PRECISION weight;
+                gSparse::PRECISION stretch;
+                _Edge(Eigen::Index U, Eigen::Index V, gSparse::PRECISION W) : u(U), v(V), weight(W), stretch(0) {}
+            };
+
+            gSparse::Util::GroundedSolver<Eigen::SimplicialLDLT<gSparse::SparsePrecisionMatrix>> _solver; //!< Factorization of the tree Laplacian
+            Eigen::ComputationInfo _info;  //!< Status of the factorization
+            double _augmentRatio;          //!< Number of off-tree edges as a fraction of node count
+
+            //! Compute the stretch of off-tree edges with respect to the spanning forest
+            inline void _computeStretch(Eigen::Index n, const std::vector<_Edge> & treeEdges, std::vector<_Edge> & offTreeEdges) const
+            {
+                // Adjacency of the forest in compressed form
+                std::vector<Eigen::Index> offset(n + 1, 0);
+                for (const _Edge & e : treeEdges) { ++offset[e.u + 1]; ++offset[e.v + 1]; }
+                for (Eigen::Index i = 0; i != n; ++i) offset[i + 1] += offset[i];
+                std::vector<Eigen::Index> neighbor(offset[n]);
+                std::vector<gSparse::PRECISION> resistance(offset[n]);
+                std::vector<Eigen::Index> fill(offset.begin(), offset.end() - 1);
+                for (const _Edge & e : treeEdges)
+                {
+                    neighbor[fill[e.u]] = e.v; resistance[fill[e.u]++] = 1.0 / e.weight;
+                    neighbor[fill[e.v]] = e.u; resistance[fill[e.v]++] = 1.0 / e.weight;
+                }
+
+                // Off-tree edges incident to each node, in compressed form
+                std::vector<std::size_t> queryOffset(n + 1, 0);
+                for (const _Edge & e : offTreeEdges) { ++queryOffset[e.u + 1]; ++queryOffset[e.v + 1]; }
+                for (Eigen::Index i = 0; i != n; ++i) queryOffset[i + 1] += queryOffset[i];
+                std::vector<std::size_t> query(queryOffset[n]);
+                std::vector<std::size_t> queryFill(queryOffset.begin(), queryOffset.end() - 1);
+                for (std::size_t q = 0; q != offTreeEdges.size(); ++q)
+                {
+                    query[queryFill[offTreeEdges[q].u]++] = q;
+                    query[queryFill[offTreeEdges[q].v]++] = q;
+                }
+
+                // Tarjan's offline lowest common ancestor. A depth-first traversal roots every tree and records
+                // the resistance to its root. A finished node joins the set of its parent, whose representative
+                // maps to the parent. When the second endpoint of an off-tree edge finishes, the set of the first
+                // endpoint maps to their lowest common ancestor.
+                std::vector<Eigen::Index> set(n), setAncestor(n), treeParent(n, -1);
+                std::vector<Eigen::Index> next(offset.begin(), offset.end() - 1);
+                std::vector<char> state(n, 0);  // 0: unvisited, 1: on the stack, 2: finished
+                std::vector<gSparse::PRECISION> rootResistance(n, 0);
+                auto findSet = [&set](Eigen::Index x)
+                {
+                    while (set[x] != x)
+                    {
+                        set[x] = set[set[x]];
+                        x = set[x];
+                    }
+                    return x;
+                };
+                std::vector<Eigen::Index> stack;
+                for (Eigen::Index root = 0; root != n; ++root)
+                {
+                    if (state[root] != 0) continue;
+                    state[root] = 1;
+                    set[root] = root;
+                    setAncestor[root] = root;
+                    stack.push_back(root);
+                    while (!stack.empty())
+                    {
+                        Eigen::Index x = stack.back();
+                        if (next[x] != offset[x + 1])
+                        {
+                            // The only visited neighbor of x is its parent
+                            Eigen::Index k = next[x]++;
+                            Eigen::Index y = neighbor[k];
+                            if (state[y] != 0) continue;
+                            state[y] = 1;
+                            set[y] = y;
+                            setAncestor[y] = y;
+                            treeParent[y] = x;
+                            rootResistance[y] = rootResistance[x] + resistance[k];
+                            stack.push_back(y);
+                            continue;
+                        }
+                        stack.pop_back();
+                        state[x] = 2;
+                        for (std::size_t q = queryOffset[x]; q != queryOffset[x + 1]; ++q)
+                        {
+                            _Edge & e = offTreeEdges[query[q]];
+                            Eigen::Index other = (e.u == x) ? e.v : e.u;
+                            if (state[other] != 2) continue;
+                            Eigen::Index lca = setAncestor[findSet(other)];
+                            e.stretch = e.weight * (rootResistance[e.u] + rootResistance[e.v] - 2 * rootResistance[lca]);
+                        }
+                        if (treeParent[x] >= 0)
+                            set[findSet(x)] = findSet(treeParent[x]);
+                    }
+                }
+            }
+        };
+    }
+}
+#endif
@@ -9,14 +9,18 @@
 #include "../Config.hpp"
 #include "../Interface/Sparsifier.hpp"
 #include "../Util/Sampling.hpp"
+#include "../Util/Random.hpp"    // Counter-based random numbers
+#include "../Util/Parallel.hpp"  // Worker threads
 
 // ER Policies
 #include "../ER/ApproximateER.hpp"
 #include "../ER/ExactER.hpp"
+#include "../CompleteGraph.hpp"  // Edges of implicit complete graphs
 
 #include <random>            // distributions
 #include <vector>            // Vector
-#include <unordered_map>     // Hashtable
+#include <utility>           // std::move
+#include <stdexcept>         // std::runtime_error
 namespace gSparse
 {
     namespace SpectralSparsifier 
@@ -29,9 +33,38 @@ namespace gSparse
         enum ER_METHODS
         {
             APPROXIMATE_ER = 0,
-            EXACT_ER = 1
+            EXACT_ER = 1,
+            APPROXIMATE_ER_CHOLESKY = 2
         };
 
+        /// \ingroup SpectralSparsifier
+        ///
+        /// This is enum type defines how ERSampling draws the edges of the sparsifier
+        ///
+        enum SAMPLING_METHODS
+        {
+            SAMPLING_WITH_REPLACEMENT = 0,  //!< Draw O(n log n / eps^2) edges with replacement, in proportion to p_e
+            INDEPENDENT_SAMPLING = 1        //!< Keep each edge independently with probability p_e, in parallel
+        };
+
+        /// \ingroup SpectralSparsifier
+        ///
+        /// Create the EffectiveResistance module of a calculation method. Unknown methods use APPROXIMATE_ER.
+        ///
+        inline gSparse::EffectiveResistance createERCalculator(ER_METHODS policy)
+        {
+            switch (policy)
+            {
+            case gSparse::SpectralSparsifier::EXACT_ER:
+                return std::make_shared<gSparse::ER::ExactER>();
+            case gSparse::SpectralSparsifier::APPROXIMATE_ER_CHOLESKY:
+                return std::make_shared<gSparse::ER::ApproximateERSPL>();
+            case gSparse::SpectralSparsifier::APPROXIMATE_ER:
+            default:
+                return std::make_shared<gSparse::ER::ApproximateER>();
+            }
+        }
+
         /// \ingroup SpectralSparsifier
         ///
         /// This class implements Spectral Sparsifier by Effective Weight Sampling.
@@ -48,6 +81,169 @@ namespace gSparse
             gSparse::EffectiveResistance _erCalculator;     //!< Pointer to EffectiveResistance module
                           
             gSparse::SpectralSparsifier::ER_METHODS _erPolicy; //!< EffectiveResistance Calculation Policy
+            gSparse::SpectralSparsifier::SAMPLING_METHODS _samplingMethod; //!< Edge sampling method
+            std::uint64_t _seed;                            //!< Seed of the effective resistance and of the sampling
+            std::size_t _threadCount;                       //!< Number of threads of independent sampling
+
+            /// Sampling probability p_e = min(1, C * w_e * R_e * log n / eps^2) of an edge.
+            /// \param scale C * log n / eps^2, which is the same for every edge
+            inline double _samplingProbability(std::size_t edgeIndex, double weight, double scale) const
+            {
+                double temp = _er(edgeIndex, 0) * weight * scale;
+                return 1.0f < temp ? 1.0f : temp;
+            }
+
+            //! Edges of a graph, read from its edge and weight lists
+            struct _ListedEdges
+            {
+                gSparse::EdgeList edges;
+                gSparse::WeightList weights;
+                inline double Weight(std::size_t k) const { return weights(k); }
+                inline std::pair<std::size_t, std::size_t> Edge(std::size_t k) const
+                {
+                    return std::make_pair(static_cast<std::size_t>(edges(k, 0)), static_cast<std::size_t>(edges(k, 1)));
+                }
+            };
+            //! Edges of a complete graph, computed from their index so that an implicit graph is never materialized
+            struct _CompleteEdges
+            {
+                const gSparse::CompleteGraph & graph;
+                double weight;
+                inline double Weight(std::size_t) const { return weight; }
+                inline std::pair<std::size_t, std::size_t> Edge(std::size_t k) const { return graph.EdgeAt(k); }
+            };
+
+            ///
+            /// Keep each edge independently with probability p_e and reweight it by 1 / p_e.
+            /// The random number of edge e is counterHash(key, e), so the result only depends on the seed,
+            /// not on the number of threads. Each thread processes a contiguous range of edges.
+            /// The sparsifier keeps every node of the graph. Throws std::runtime_error if no edge is kept.
+            ///
+            template <typename Edges>
+            inline gSparse::Graph _independentSampling(const Edges & source, double scale) const
+            {
+                const std::size_t edgeCount = static_cast<std::size_t>(_er.rows());
+                const std::size_t chunks = gSparse::Util::resolveThreadCount(_threadCount);
+                const std::uint64_t key = gSparse::Util::deriveSeed(_seed, 2);
+
+                // Pass 1: every chunk decides its edges and counts what it keeps
+                std::vector<unsigned char> kept(edgeCount, 0);
+                std::vector<std::size_t> offset(chunks + 1, 0);
+                gSparse::Util::parallelFor(0, chunks, chunks, [&](std::size_t first, std::size_t last)
+                {
+                    for (std::size_t c = first; c != last; ++c)
+                    {
+                        std::size_t count = 0;
+                        for (std::size_t i = edgeCount * c / chunks; i != edgeCount * (c + 1) / chunks; ++i)
+                        {
+                            double u = gSparse::Util::toUniform(gSparse::Util::counterHash(key, i));
+                            if (u < _samplingProbability(i, source.Weight(i), scale))
+                            {
+                                kept[i] = 1;
+                                ++count;
+                            }
+                        }
+                        offset[c + 1] = count;
+                    }
+                });
+                for (std::size_t c = 0; c != chunks; ++c) offset[c + 1] += offset[c];
+                if (offset[chunks] == 0)
+                {
+                    throw std::runtime_error("SpectralSparsifier by ER: Independent sampling kept no edges. Increase C or decrease Epsilon");
+                }
+
+                // Pass 2: every chunk writes its kept edges from its offset, in original edge order
+                gSparse::EdgeMatrix resultEdge(offset[chunks], 2);
+                gSparse::PrecisionRowMatrix resultWeight(offset[chunks], 1);
+                gSparse::Util::parallelFor(0, chunks, chunks, [&](std::size_t first, std::size_t last)
+                {
+                    for (std::size_t c = first; c != last; ++c)
+                    {
+                        std::size_t row = offset[c];
+                        for (std::size_t i = edgeCount * c / chunks; i != edgeCount * (c + 1) / chunks; ++i)
+                        {
+                            if (!kept[i]) continue;
+                            const std::pair<std::size_t, std::size_t> edge = source.Edge(i);
+                            const double weight = source.Weight(i);
+                            resultEdge(row, 0) = static_cast<gSparse::NodeIndex>(edge.first);
+                            resultEdge(row, 1) = static_cast<gSparse::NodeIndex>(edge.second);
+                            resultWeight(row, 0) = static_cast<gSparse::PRECISION>(weight / _samplingProbability(i, weight, scale));
+                            ++row;
+                        }
+                    }
+                });
+                return std::make_shared<gSparse::UndirectedGraph>(std::move(resultEdge), std::move(resultWeight), _graph->GetNodeCount());
+            }
+            ///
+            /// Draw O(n log n / eps^2) edges with replacement in proportion to p_e.
+            /// The sparsifier keeps every node of the graph. Throws std::runtime_error if every p_e is zero.
+            ///
+            template <typename Edges>
+            inline gSparse::Graph _samplingWithReplacement(const Edges & source, double scale) const
+            {
+                // Build probability distribution
+                std::vector<double> samplingWeights;
+                samplingWeights.reserve(_er.rows());
+
+                //Generate sampling weights (p) for each edges
+                double totalWeight = 0.0;
+                for (std::size_t i = 0; i != _er.rows(); ++i)
+                {
+                    samplingWeights.push_back(_samplingProbability(i, source.Weight(i), scale));
+                    totalWeight += samplingWeights.back();
+                }
+                // AliasTable falls back to uniform draws, which would divide weights by a zero probability
+                if (!(totalWeight > 0.0))
+                {
+                    throw std::runtime_error("SpectralSparsifier by ER: Every edge has a zero sampling probability");
+                }
+
+                // Build an alias table based on sampling weight. Each draw takes constant time.
+                gSparse::Util::AliasTable samplingTable(samplingWeights.begin(), samplingWeights.end());
+
+                // The algorithm samples O(n log n / ep^2) times edges
+                std::size_t samplingCount = static_cast<std::size_t>(
+                    std::ceil(_graph->GetNodeCount() * std::log(_graph->GetNodeCount()) / std::pow(_eps, 2)));
+                // Count how often each edge is sampled in a flat array indexed by edge id
+                std::vector<std::size_t> sampledCount(samplingWeights.size(), 0);
+                gSparse::Util::RandomStream stream(gSparse::Util::deriveSeed(_seed, 1));
+                for (std::size_t i = 0; i != samplingCount; ++i)
+                {
+                    ++sampledCount[gSparse::Util::sample(samplingTable, stream)];
+                }
+                std::size_t sampledEdges = 0;
+                for (std::size_t count : sampledCount)
+                {
+                    if (count != 0) ++sampledEdges;
+                }
+
+                // Build Graph object from sparsified information. Edges keep their original order.
+                // Each sample of an edge contributes its weight divided by its sampling weight.
+                gSparse::EdgeMatrix resultEdge(sampledEdges, 2);
+                gSparse::PrecisionRowMatrix resultWeight(sampledEdges, 1);
+                std::size_t row = 0;
+                for (std::size_t edgeIndex = 0; edgeIndex != sampledCount.size(); ++edgeIndex)
+                {
+                    if (sampledCount[edgeIndex] == 0) continue;
+                    const std::pair<std::size_t, std::size_t> edge = source.Edge(edgeIndex);
+                    resultEdge(row, 0) = static_cast<gSparse::NodeIndex>(edge.first);
+                    resultEdge(row, 1) = static_cast<gSparse::NodeIndex>(edge.second);
+                    resultWeight(row, 0) = static_cast<gSparse::PRECISION>(sampledCount[edgeIndex] *
+                        (source.Weight(edgeIndex) / samplingWeights[edgeIndex]));
+                    ++row;
+                }
+                return std::make_shared<gSparse::UndirectedGraph>(std::move(resultEdge), std::move(resultWeight), _graph->GetNodeCount());
+            }
+            //! Sample the edges of source with the sampling method of the sparsifier
+            template <typename Edges>
+            inline gSparse::Graph _sample(const Edges & source, double scale) const
+            {
+                if (_samplingMethod == gSparse::SpectralSparsifier::INDEPENDENT_SAMPLING)
+                {
+                    return _independentSampling(source, scale);
+                }
+                return _samplingWithReplacement(source, scale);
+            }
         public:
             ///
             /// Constructor to create a ISparsifier object to perform Spectral Sparsification by Effective Resistance
@@ -62,6 +258,8 @@ namespace gSparse
             /// \param ERPolicy EffectiveResistance calculation method. 
             ///                 APPROXIMATE_ER:  Default. Approximate EffectiveResistance with an error. This should be sufficient for Spectral Sparsifier.                        
             ///                 EXACT_ER:  Calculate graph exact EffectiveResistance. This is very slow and not recommended.
+            ///                 APPROXIMATE_ER_CHOLESKY:  Approximate EffectiveResistance solved with an approximate Cholesky preconditioner.
+            ///                                           Recommended for large graphs.
             ERSampling(const gSparse::Graph & graph, 
             double C = 4.0f, 
             double Epsilon = 0.3f,
@@ -73,6 +271,9 @@ namespace gSparse
                 _graph = graph;
                 _computeInfo = gSparse::NOT_COMPUTED;
                 SetERPolicy(ERPolicy);
+                _samplingMethod = gSparse::SpectralSparsifier::SAMPLING_WITH_REPLACEMENT;
+                _seed = gSparse::Util::nextSeed();
+                _threadCount = 0;
             }
 
             ///
@@ -80,13 +281,15 @@ namespace gSparse
             ///
             virtual inline gSparse::COMPUTE_INFO Compute()
             {
-                //Calculate Effective Resistance
+                //Calculate Effective Resistance. Randomized calculators get their own seed derived from the sparsifier's.
+                _erCalculator->SetSeed(gSparse::Util::deriveSeed(_seed, 0));
                 _computeInfo = _erCalculator->CalculateER(_er, _graph);
                 return _computeInfo;
             }
             ///
             /// Sampling a sparsifier from a dense graph based on calculate effective weight.
             /// As this is a random algorithm, it may need several attempts to get an acceptable graph.
+            /// The sparsified graph has the node count of the original graph, even if some nodes lose every edge.
             ///
             virtual inline gSparse::Graph GetSparsifiedGraph()
             {
@@ -94,68 +297,32 @@ namespace gSparse
                 {
                     throw std::logic_error("SpectralSparsifier by ER: User must run Compute before GetSparsifiedGraph()");
                 }
-                // Build probability distribution
-                std::vector<double> samplingWeights;
-                samplingWeights.reserve(_er.rows());
-
-                //Generate sampling weights (p) for each edges
-                for (std::size_t i = 0; i != _er.rows(); ++i)
-                {
-                    double temp = _er(i, 0) * _graph->GetWeightList()(i) * _c * std::log(_graph->GetNodeCount()) / std::pow(_eps, 2);
-                    double prob = 1.0f < temp ? 1.0f : temp;
-                    samplingWeights.push_back(prob);
-                }
-
-                // Build a discrete distribution based on sampling weight
-                std::discrete_distribution<> samplingDistribution(samplingWeights.begin(), samplingWeights.end());
-
-                // The algorithm samples O(n log n / ep^2) times edges
-                std::size_t samplingCount = static_cast<std::size_t>(
-                    std::ceil(_graph->GetNodeCount() * std::log(_graph->GetNodeCount()) / std::pow(_eps, 2)));
-                // Sample edges from a distribution, then add to a hash table
-                std::unordered_map<std::size_t, gSparse::PRECISION> sparsifiedMap;
-                for (std::size_t i = 0; i != samplingCount; ++i)
+                // Complete graphs may be implicit. Their edges are computed, so the edge list is never built.
+                const double scale = _c * std::log(_graph->GetNodeCount()) / std::pow(_eps, 2);
+                const gSparse::CompleteGraph * complete = dynamic_cast<const gSparse::CompleteGraph *>(_graph.get());
+                if (complete != nullptr)
                 {
-                    
-                    std::size_t edgeIndex = gSparse::Util::sample(samplingDistribution);
-                    sparsifiedMap[edgeIndex] += _graph->GetWeightList()(edgeIndex) / samplingWeights[edgeIndex];
+                    return _sample(_CompleteEdges{ *complete, static_cast<double>(complete->GetWeight()) }, scale);
                 }
-                
-                // Build Graph object from sparsified information
-                gSparse::EdgeMatrix resultEdge(sparsifiedMap.size(), 2);
-                gSparse::PrecisionRowMatrix resultWeight(sparsifiedMap.size(), 1);
-                std::size_t row = 0;
-                for (auto x = sparsifiedMap.begin(); x != sparsifiedMap.end(); ++x)
-                {
-                    resultEdge(row, 0) = _graph->GetEdgeList()(x->first, 0);
-                    resultEdge(row, 1) = _graph->GetEdgeList()(x->first, 1);
-                    resultWeight(row, 0) = x->second;
-                    ++row;
-                }
-                return std::make_shared<gSparse::UndirectedGraph>(resultEdge, resultWeight);
+                return _sample(_ListedEdges{ _graph->GetEdgeList(), _graph->GetWeightList() }, scale);
             }
             ///
             /// Set EffectiveResistance calculation methid.
             ///
             /// \param ERPolicy EffectiveResistance calculation method. 
             ///                 APPROXIMATE_ER:  Default. Approximate EffectiveResistance with an error. This should be sufficient for Spectral Sparsifier.                        
+            ///                 EXACT_ER:  Calculate graph exact EffectiveResistance.
+            ///                 APPROXIMATE_ER_CHOLESKY:  Approximate EffectiveResistance solved with an approximate Cholesky preconditioner.
             ///
             inline void SetERPolicy(ER_METHODS policy)
             {
                 assert (policy == gSparse::SpectralSparsifier::APPROXIMATE_ER || 
-                        policy == gSparse::SpectralSparsifier::EXACT_ER);
+                        policy == gSparse::SpectralSparsifier::EXACT_ER ||
+                        policy == gSparse::SpectralSparsifier::APPROXIMATE_ER_CHOLESKY);
                 
-                switch (policy)
-                {
-                case gSparse::SpectralSparsifier::EXACT_ER:
-                    _erCalculator = std::make_shared<gSparse::ER::ExactER>(); 
-                    _erPolicy = gSparse::SpectralSparsifier::EXACT_ER;
-                 break;
-                case gSparse::SpectralSparsifier::APPROXIMATE_ER:
-                default:
-                    _erCalculator = std::make_shared<gSparse::ER::ApproximateER>();
-                    _erPolicy = gSparse::SpectralSparsifier::APPROXIMATE_ER;
-                }
+                _erCalculator = createERCalculator(policy);
+                _erPolicy = policy == gSparse::SpectralSparsifier::EXACT_ER || policy == gSparse::SpectralSparsifier::APPROXIMATE_ER_CHOLESKY
+                    ? policy : gSparse::SpectralSparsifier::APPROXIMATE_ER;
             }
             /// Set Hyper-parameter C
             /// \param C        C hyper-parameter of Spectral Sparsifier by Effective Resistance. 
@@ -178,6 +345,33 @@ namespace gSparse
                 #endif
                 _eps = Epsilon;
             }
+            ///
+            /// Set how edges of the sparsifier are drawn.
+            ///
+            /// \param method   SAMPLING_WITH_REPLACEMENT:  Default. Draw O(n log n / eps^2) edges with replacement.
+            ///                 INDEPENDENT_SAMPLING:  Keep each edge independently with probability p_e and reweight it by 1 / p_e.
+            ///                                        Runs in parallel.
+            ///
+            inline void SetSamplingMethod(SAMPLING_METHODS method)
+            {
+                #ifndef NDEBUG
+                    assert(method == gSparse::SpectralSparsifier::SAMPLING_WITH_REPLACEMENT ||
+                           method == gSparse::SpectralSparsifier::INDEPENDENT_SAMPLING);
+                #endif
+                _samplingMethod = method;
+            }
+            /// Set the seed of the sparsifier. It seeds both the effective resistance calculation and the edge sampling,
+            /// so a seed always yields the same sparsifier, regardless of the number of threads.
+            /// Default is gSparse::Util::nextSeed().
+            inline void SetSeed(std::uint64_t seed) { _seed = seed; }
+            /// Set number of threads of independent sampling. Default is 0, which uses every hardware thread.
+            inline void SetThreadCount(std::size_t threadCount) { _threadCount = threadCount; }
+            /// Get the sparsifier's current sampling method
+            inline gSparse::SpectralSparsifier::SAMPLING_METHODS GetSamplingMethod() const { return _samplingMethod; }
+            /// Get the seed of the sparsifier
+            inline std::uint64_t GetSeed() const { return _seed; }
+            /// Get number of threads of independent sampling. Zero means every hardware thread.
+            inline std::size_t GetThreadCount() const { return _threadCount; }
             /// Get the sparsifier's current configuration for hyper-parameter C
             inline double GetC() const { return _c; }
             /// Get the sparsifier's current configuration for hyper-parameter Epsilon
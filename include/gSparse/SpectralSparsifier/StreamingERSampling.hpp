@@ -0,0 +1,252 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_SPECTRALSPARSIFIER_STREAMINGERSAMPLING_HPP
+#define GSPARSE_SPECTRALSPARSIFIER_STREAMINGERSAMPLING_HPP
+
+// Internal includes
+#include "../Config.hpp"
+#include "../Interface/Sparsifier.hpp"
+#include "../Interface/GraphStreamReader.hpp"
+#include "../UndirectedGraph.hpp"
+#include "../Util/Random.hpp"    // Counter-based random numbers
+#include "ERSampling.hpp"        // ER Policies
+
+#include <cmath>             // log, ceil
+#include <algorithm>         // std::max
+#include <stdexcept>         // logic_error, runtime_error
+#include <utility>           // std::move
+namespace gSparse
+{
+    namespace SpectralSparsifier
+    {
+        /// \ingroup SpectralSparsifier
+        ///
+        /// This class implements a semi-streaming Spectral Sparsifier by Effective Resistance Sampling.
+        /// Edges are read in batches from a gSparse::IGraphStreamReader into a buffer that holds the current sparsifier.
+        /// Once the buffer exceeds the reduce threshold, it is resparsified: the effective resistances of the buffered
+        /// graph are computed and each edge is kept with probability p_e = min(1, C * w_e * R_e * log n / eps^2) and
+        /// reweighted by 1 / p_e (merge-and-reduce). The buffer is resparsified once more at the end of the stream.
+        ///
+        /// The buffer holds at most the reduce threshold plus one batch of edges. By default the threshold is twice
+        /// the expected size C * n log n / eps^2 of a sparsifier of the n nodes seen so far, so memory is
+        /// O(n log n / eps^2) regardless of the number of edges in the stream.
+        /// The buffered graph approximates a subgraph of the whole graph, whose effective resistances are never smaller,
+        /// so edges tend to be oversampled. The error of every resparsification adds up, however: a smaller epsilon
+        /// than for ERSampling gives the same quality.
+        ///
+        class StreamingERSampling : public ISparsifier
+        {
+        protected:
+            gSparse::GraphStreamReader _reader;             //!< Source of the edges
+            double _c;                                      //!< C-hyper parameter.
+            double _eps;                                    //!< epsilon hyper-parameter.
+            gSparse::COMPUTE_INFO _computeInfo;             //!< Status of sparsifier
+            gSparse::EffectiveResistance _erCalculator;     //!< Pointer to EffectiveResistance module
+            gSparse::SpectralSparsifier::ER_METHODS _erPolicy; //!< EffectiveResistance Calculation Policy
+            std::uint64_t _seed;                            //!< Seed of the effective resistances and of the sampling
+            std::size_t _reduceThreshold;                   //!< Buffered edges that trigger a resparsification, or 0 for automatic
+
+            gSparse::EdgeMatrix _edges;                     //!< Buffered edges. The first _edgeCount rows are used.
+            gSparse::PrecisionRowMatrix _weights;           //!< Buffered weights
+            std::size_t _edgeCount;                         //!< Number of buffered edges
+            std::size_t _nodeCount;                         //!< Number of nodes seen so far
+            std::size_t _reduceCount;                       //!< Number of resparsifications
+            std::size_t _peakEdgeCount;                     //!< Largest number of buffered edges
+
+            /// Buffered edges that trigger a resparsification
+            inline std::size_t _threshold() const
+            {
+                if (_reduceThreshold != 0) return _reduceThreshold;
+                const double n = static_cast<double>(std::max<std::size_t>(_nodeCount, 2));
+                return static_cast<std::size_t>(std::ceil(2.0 * _c * n * std::log(n) / std::pow(_eps, 2)));
+            }
+            /// Append a batch to the buffer, growing it geometrically up to the threshold plus the batch
+            inline void _append(const gSparse::EdgeMatrix & edges, const gSparse::PrecisionRowMatrix & weights)
+            {
+                const std::size_t count = static_cast<std::size_t>(edges.rows());
+                if (_edgeCount + count > static_cast<std::size_t>(_edges.rows()))
+                {
+                    const Eigen::Index capacity = static_cast<Eigen::Index>(
+                        std::max(_edgeCount + count, std::min(2 * _edgeCount, _threshold() + count)));
+                    _edges.conservativeResize(capacity, 2);
+                    _weights.conservativeResize(capacity, 1);
+                }
+                _edges.middleRows(static_cast<Eigen::Index>(_edgeCount), edges.rows()) = edges;
+                _weights.middleRows(static_cast<Eigen::Index>(_edgeCount), weights.rows()) = weights;
+                _edgeCount += count;
+                if (count != 0) _nodeCount = std::max(_nodeCount, static_cast<std::size_t>(edges.maxCoeff()) + 1);
+                _peakEdgeCount = std::max(_peakEdgeCount, _edgeCount);
+            }
+            ///
+            /// Resparsify the buffer. Edges are kept in place, in their buffered order.
+            /// The random number of buffered edge e in round r is counterHash(deriveSeed(seed, 2r + 1), e).
+            ///
+            inline gSparse::COMPUTE_INFO _reduce()
+            {
+                // Nothing to resparsify, e.g. after batches without edges
+                if (_edgeCount == 0) return gSparse::SUCCESSFUL;
+                gSparse::PrecisionRowMatrix er;
+                {
+                    // The graph wraps the buffer without copying it
+                    gSparse::Graph graph = std::make_shared<gSparse::UndirectedGraph>(
+                        gSparse::EdgeList(_edges.data(), static_cast<Eigen::Index>(_edgeCount), 2),
+                        gSparse::WeightList(_weights.data(), static_cast<Eigen::Index>(_edgeCount), 1));
+                    _erCalculator->SetSeed(gSparse::Util::deriveSeed(_seed, 2 * _reduceCount));
+                    gSparse::COMPUTE_INFO info = _erCalculator->CalculateER(er, graph);
+                    if (info != gSparse::SUCCESSFUL) return info;
+                }
+                const double scale = _c * std::log(static_cast<double>(std::max<std::size_t>(_nodeCount, 2))) / std::pow(_eps, 2);
+                const std::uint64_t key = gSparse::Util::deriveSeed(_seed, 2 * _reduceCount + 1);
+                std::size_t kept = 0;
+                for (std::size_t i = 0; i != _edgeCount; ++i)
+                {
+                    double p = std::min(1.0, scale * _weights(i) * er(i, 0));
+                    if (p < 1.0 && !(gSparse::Util::toUniform(gSparse::Util::counterHash(key, i)) < p)) continue;
+                    _edges(kept, 0) = _edges(i, 0);
+                    _edges(kept, 1) = _edges(i, 1);
+                    _weights(kept) = static_cast<gSparse::PRECISION>(_weights(i) / p);
+                    ++kept;
+                }
+                _edgeCount = kept;
+                ++_reduceCount;
+                return gSparse::SUCCESSFUL;
+            }
+        public:
+            ///
+            /// Constructor to create a ISparsifier object to perform semi-streaming Spectral Sparsification by Effective Resistance
+            ///
+            /// \param reader   Smart Pointer to the IGraphStreamReader that yields the edges of the dense graph.
+            /// \param C        C hyper-parameter of Spectral Sparsifier by Effective Resistance.
+            ///                 As described by paper. This should be a large constant.
+            ///                 Default value is 4.0.
+            /// \param Epsilon  Epsilon hyper-parameter. This should be between 0.0 and 1.0
+            ///                 Lower epsilon will yeild a denser sparsifier and a larger buffer.
+            /// \param ERPolicy EffectiveResistance calculation method of every resparsification. See ERSampling.
+            ///
+            StreamingERSampling(const gSparse::GraphStreamReader & reader,
+            double C = 4.0f,
+            double Epsilon = 0.3f,
+            gSparse::SpectralSparsifier::ER_METHODS ERPolicy = gSparse::SpectralSparsifier::APPROXIMATE_ER
+            )
+            {
+                if (reader == nullptr)
+                {
+                    throw std::invalid_argument("StreamingERSampling: reader must not be NULL");
+                }
+                _reader = reader;
+                SetC(C);
+                SetEpsilon(Epsilon);
+                SetERPolicy(ERPolicy);
+                _computeInfo = gSparse::NOT_COMPUTED;
+                _seed = gSparse::Util::nextSeed();
+                _reduceThreshold = 0;
+                _edgeCount = _nodeCount = _reduceCount = _peakEdgeCount = 0;
+            }
+
+            ///
+            /// Read the whole stream once, resparsifying the buffer whenever it exceeds the reduce threshold.
+            ///
+            virtual inline gSparse::COMPUTE_INFO Compute()
+            {
+                _edges.resize(0, 2);
+                _weights.resize(0, 1);
+                _edgeCount = _nodeCount = _reduceCount = _peakEdgeCount = 0;
+                _computeInfo = gSparse::NOT_COMPUTED;
+
+                gSparse::COMPUTE_INFO info = gSparse::SUCCESSFUL;
+                bool pending = false;  // Whether edges were read since the last resparsification
+                gSparse::EdgeMatrix edges;
+                gSparse::PrecisionRowMatrix weights;
+                _reader->Reset();
+                while (_reader->ReadBatch(edges, weights))
+                {
+                    _append(edges, weights);
+                    pending = true;
+                    if (_edgeCount > _threshold())
+                    {
+                        if ((info = _reduce()) != gSparse::SUCCESSFUL) return _computeInfo = info;
+                        pending = false;
+                    }
+                }
+                if (pending && (info = _reduce()) != gSparse::SUCCESSFUL) return _computeInfo = info;
+                _edges.conservativeResize(static_cast<Eigen::Index>(_edgeCount), 2);
+                _weights.conservativeResize(static_cast<Eigen::Index>(_edgeCount), 1);
+                return _computeInfo = gSparse::SUCCESSFUL;
+            }
+            ///
+            /// Return the sparsifier computed from the stream. Edges are in stream order.
+            /// The sparsifier has every node seen in the stream, even if some nodes lose every edge.
+            /// Throws std::runtime_error if the stream was empty or the sparsifier kept no edges.
+            ///
+            virtual inline gSparse::Graph GetSparsifiedGraph()
+            {
+                if (_computeInfo == gSparse::NOT_COMPUTED)
+                {
+                    throw std::logic_error("Streaming SpectralSparsifier by ER: User must run Compute before GetSparsifiedGraph()");
+                }
+                if (_edgeCount == 0)
+                {
+                    throw std::runtime_error("Streaming SpectralSparsifier by ER: The sparsifier has no edges. The stream is empty, or C is too small or Epsilon too large");
+                }
+                return std::make_shared<gSparse::UndirectedGraph>(gSparse::EdgeMatrix(_edges), gSparse::PrecisionRowMatrix(_weights), _nodeCount);
+            }
+            ///
+            /// Set EffectiveResistance calculation method of every resparsification. See ERSampling::SetERPolicy.
+            ///
+            inline void SetERPolicy(ER_METHODS policy)
+            {
+                assert (policy == gSparse::SpectralSparsifier::APPROXIMATE_ER ||
+                        policy == gSparse::SpectralSparsifier::EXACT_ER ||
+                        policy == gSparse::SpectralSparsifier::APPROXIMATE_ER_CHOLESKY);
+                _erCalculator = createERCalculator(policy);
+                _erPolicy = policy == gSparse::SpectralSparsifier::EXACT_ER || policy == gSparse::SpectralSparsifier::APPROXIMATE_ER_CHOLESKY
+                    ? policy : gSparse::SpectralSparsifier::APPROXIMATE_ER;
+            }
+            /// Set Hyper-parameter C
+            /// \param C        C hyper-parameter of Spectral Sparsifier by Effective Resistance.
+            ///                 As described by paper. This should be a large constant.
+            inline void SetC(double C)
+            {
+                #ifndef NDEBUG
+                    assert(C > 0.0f);
+                #endif
+                _c = C;
+            }
+            /// Set Hyper-parameter Epsilon
+            /// \param Epsilon  Epsilon hyper-parameter. This should be between 0.0 and 1.0
+            inline void SetEpsilon(double Epsilon)
+            {
+                #ifndef NDEBUG
+                    assert(Epsilon > 0.0f);
+                #endif
+                _eps = Epsilon;
+            }
+            /// Set the number of buffered edges that triggers a resparsification.
+            /// Default is 0, which uses 2 * C * n log n / eps^2 for the n nodes seen so far.
+            inline void SetReduceThreshold(std::size_t edges) { _reduceThreshold = edges; }
+            /// Set the seed of the sparsifier. It seeds the effective resistance calculations and the edge sampling,
+            /// so a seed and a batch size always yield the same sparsifier.
+            /// Default is gSparse::Util::nextSeed().
+            inline void SetSeed(std::uint64_t seed) { _seed = seed; }
+            /// Get the seed of the sparsifier
+            inline std::uint64_t GetSeed() const { return _seed; }
+            /// Get the number of buffered edges that triggers a resparsification. Zero means automatic.
+            inline std::size_t GetReduceThreshold() const { return _reduceThreshold; }
+            /// Get the number of resparsifications of the last Compute
+            inline std::size_t GetReduceCount() const { return _reduceCount; }
+            /// Get the largest number of edges buffered during the last Compute
+            inline std::size_t GetPeakEdgeCount() const { return _peakEdgeCount; }
+            /// Get the sparsifier's current configuration for hyper-parameter C
+            inline double GetC() const { return _c; }
+            /// Get the sparsifier's current configuration for hyper-parameter Epsilon
+            inline double GetEpsilon() const { return _eps; }
+            /// Get the sparsifier's current Effective Resistance policy
+            inline gSparse::SpectralSparsifier::ER_METHODS GetERPolicy() const { return _erPolicy; }
+            /// Get the sparsifier's current computation information
+            inline gSparse::COMPUTE_INFO GetInfo() const { return _computeInfo; }
+        };
+    }
+}
+#endif
@@ -16,25 +16,29 @@
 #include <cstddef>   // size_t definition
 #include <cmath>     
 #include <memory>    // Shared_ptr
+#include <atomic>    // Lazily built representations
+#include <mutex>
+#include <new>       // Placement new to rebind Eigen::Map
+#include <utility>   // std::move
 
 #include "Config.hpp"
 #include "Interface/Graph.hpp"
 #include "Interface/GraphReader.hpp"
-
-/* TODO:
-    // Support move operator. Review Eigen documentation.
-*/
+#include "Util/Laplacian.hpp"  // Laplacian assembly
 
 namespace gSparse
 {
     //! An Undirected Graph class
     /*!
         This class provides a multiple representation of an Undirected, Simple graph. 
+        Only the edge and weight lists are stored on construction. Each matrix representation is built the
+        first time it is requested, once even when several threads request it at the same time, and can be
+        freed again with the Release functions.
     */
 	class UndirectedGraph : public IGraph
 	{
 	public:
-		//! Graph data type should not be copied by value
+		//! Graph data type should not be copied by value. Use the move constructor instead.
 		UndirectedGraph(const UndirectedGraph & graph)  = delete;  
         /*{
             // Call assignment operator
@@ -83,6 +87,15 @@ namespace gSparse
 			_weights = gSparse::PrecisionMatrix::Ones(Edges.rows(), 1);
 			_initializeSystem();
 		}
+		//! A constructor that takes over the buffer of an Edge list. Weight sets to one.
+        /*!
+        \param Edges: An Eigen Matrix containing Edge List. It is left empty.
+        */
+		UndirectedGraph(gSparse::EdgeMatrix && Edges) :_edges(std::move(Edges))
+		{
+			_weights = gSparse::PrecisionMatrix::Ones(_edges.rows(), 1);
+			_initializeSystem();
+		}
         //! A constructor to initialize graph based from Edge data. Weight sets to one.
         /*!
         \param Edges: An Eigen Matrix containing Edge List.
@@ -95,136 +108,302 @@ namespace gSparse
 		{
 			_initializeSystem();
 		}
-        //! Return Graph's Adjancency Matrix
-		virtual inline const gSparse::SparsePrecisionMatrix & GetAdjacentMatrix() const { return _adjMatrix; }
-		//! Return Graph's Incident Matrix
-        virtual inline const gSparse::SparsePrecisionMatrix & GetIncidentMatrix() const { return _incidentMatrix; }
-		//! Return Graph's Degree Matrix
-        virtual inline const gSparse::SparsePrecisionMatrix & GetDegreeMatrix() const { return _degMatrix; }
-		//! Return Graph's Weight Matrix
-        virtual inline const gSparse::SparsePrecisionMatrix & GetWeightMatrix() const { return _weightMatrix; }
-		//! Return Graph's Laplacian Matrix
-        virtual inline const gSparse::SparsePrecisionMatrix &  GetLaplacianMatrix() const { return _laplacianMatrix; }
+        //! A constructor that takes over the buffers of Edge and Weight lists, without copying them.
+        /*!
+        \param Edges: An Eigen Matrix containing Edge List. It is left empty.
+        \param Weights: An Eigen Matrix containing associated Weights. It is left empty.
+        */
+		UndirectedGraph(gSparse::EdgeMatrix && Edges,
+			gSparse::PrecisionRowMatrix && Weights) :
+			_edges(std::move(Edges)),
+			_weights(std::move(Weights))
+		{
+			_initializeSystem();
+		}
+        //! A constructor that takes over the buffers of Edge and Weight lists and keeps nodes without edges.
+        /*!
+        \param Edges: An Eigen Matrix containing Edge List. It is left empty.
+        \param Weights: An Eigen Matrix containing associated Weights. It is left empty.
+        \param NodeCount: Number of nodes. Nodes past the largest endpoint in Edges are isolated.
+        */
+		UndirectedGraph(gSparse::EdgeMatrix && Edges,
+			gSparse::PrecisionRowMatrix && Weights,
+			std::size_t NodeCount) :
+			_edges(std::move(Edges)),
+			_weights(std::move(Weights))
+		{
+			_initializeSystem();
+			if (NodeCount < _nodeCount)
+			{
+				std::stringstream ss;
+				ss << "UndirectedGraph: NodeCount: " << NodeCount << " is less than the " << _nodeCount << " nodes of the edges" << std::endl;
+				throw std::invalid_argument(ss.str());
+			}
+			_nodeCount = NodeCount;
+		}
+        //! A constructor that wraps Edge and Weight lists owned by the caller, without copying them.
+        /*!
+            The memory must stay valid and unchanged for the lifetime of the graph.
+        \param Edges: A map of a row-major m x 2 Edge List, e.g. gSparse::EdgeList(pointer, m, 2).
+        \param Weights: A map of an m x 1 Weight List, e.g. gSparse::WeightList(pointer, m, 1).
+        */
+		UndirectedGraph(const gSparse::EdgeList & Edges,
+			const gSparse::WeightList & Weights) :
+			_edgeList(Edges),
+			_weightList(Weights)
+		{
+			_initializeSystem();
+		}
+        //! A move constructor. graph is left without edges.
+		UndirectedGraph(UndirectedGraph && graph) noexcept
+		{
+			*this = std::move(graph);
+		}
+        //! A move assignment operator. graph is left without edges.
+        /*!
+            References to the matrices of either graph become invalid.
+        */
+		UndirectedGraph & operator=(UndirectedGraph && graph) noexcept
+		{
+			if (this != &graph)
+			{
+				_edges = std::move(graph._edges);
+				_weights = std::move(graph._weights);
+				// A moved Eigen matrix keeps its buffer, so a view of an owned list stays valid
+				_rebind(_edgeList, graph._edgeList.data(), graph._edgeList.rows(), graph._edgeList.cols());
+				_rebind(_weightList, graph._weightList.data(), graph._weightList.rows(), graph._weightList.cols());
+				_edgeCount = graph._edgeCount;
+				_nodeCount = graph._nodeCount;
+				_move(_adjMatrix, graph._adjMatrix);
+				_move(_degMatrix, graph._degMatrix);
+				_move(_incidentMatrix, graph._incidentMatrix);
+				_move(_weightMatrix, graph._weightMatrix);
+				_move(_laplacianMatrix, graph._laplacianMatrix);
+
+				graph._edges.resize(0, 2);
+				graph._weights.resize(0, 1);
+				_rebind(graph._edgeList, graph._edges.data(), 0, 2);
+				_rebind(graph._weightList, graph._weights.data(), 0, 1);
+				graph._edgeCount = 0;
+				graph._nodeCount = 0;
+			}
+			return *this;
+		}
+        //! Return Graph's Adjancency Matrix. It is built on first access.
+		virtual inline const gSparse::SparsePrecisionMatrix & GetAdjacentMatrix() const { return _cached(_adjMatrix, &UndirectedGraph::_buildAdjacentMatrix); }
+		//! Return Graph's Incident Matrix. It is built on first access.
+        virtual inline const gSparse::SparsePrecisionMatrix & GetIncidentMatrix() const { return _cached(_incidentMatrix, &UndirectedGraph::_buildIncidentMatrix); }
+		//! Return Graph's Degree Matrix. It is built on first access.
+        virtual inline const gSparse::SparsePrecisionMatrix & GetDegreeMatrix() const { return _cached(_degMatrix, &UndirectedGraph::_buildDegreeMatrix); }
+		//! Return Graph's Weight Matrix. It is built on first access.
+        virtual inline const gSparse::SparsePrecisionMatrix & GetWeightMatrix() const { return _cached(_weightMatrix, &UndirectedGraph::_buildWeightMatrix); }
+		//! Return Graph's Laplacian Matrix. It is built on first access.
+        virtual inline const gSparse::SparsePrecisionMatrix &  GetLaplacianMatrix() const { return _cached(_laplacianMatrix, &UndirectedGraph::_buildLaplacianMatrix); }
 		//! Return Graph's Edge List Matrix
-        virtual inline const gSparse::EdgeMatrix & GetEdgeList() const { return _edges; }
+        virtual inline gSparse::EdgeList GetEdgeList() const { return _edgeList; }
 		//! Return Graph's Weight List Matrix
-        virtual inline const gSparse::PrecisionRowMatrix & GetWeightList() const { return _weights; }
+        virtual inline gSparse::WeightList GetWeightList() const { return _weightList; }
         //! Return the number of Edges in the Graph
 		virtual inline std::size_t GetEdgeCount() const { return _edgeCount; }
 		//! Return the number of Nodes in the Graph
         virtual inline std::size_t GetNodeCount() const { return _nodeCount; }
+
+        //! Free the Adjacency Matrix. It is rebuilt on the next access.
+        inline void ReleaseAdjacentMatrix() { _release(_adjMatrix); }
+        //! Free the Incident Matrix. It is rebuilt on the next access.
+        inline void ReleaseIncidentMatrix() { _release(_incidentMatrix); }
+        //! Free the Degree Matrix. It is rebuilt on the next access.
+        inline void ReleaseDegreeMatrix() { _release(_degMatrix); }
+        //! Free the Weight Matrix. It is rebuilt on the next access.
+        inline void ReleaseWeightMatrix() { _release(_weightMatrix); }
+        //! Free the Laplacian Matrix. It is rebuilt on the next access.
+        inline void ReleaseLaplacianMatrix() { _release(_laplacianMatrix); }
+        //! Free every matrix representation. The edge and weight lists are kept.
+        /*!
+            References returned by the matrix getters become invalid.
+            No other thread may use a matrix of this graph during the call.
+        */
+        virtual inline void ReleaseMatrices()
+        {
+            ReleaseAdjacentMatrix();
+            ReleaseIncidentMatrix();
+            ReleaseDegreeMatrix();
+            ReleaseWeightMatrix();
+            ReleaseLaplacianMatrix();
+        }
+        //! Return true if the Laplacian Matrix has been built and not released since.
+        inline bool HasLaplacianMatrix() const { return _laplacianMatrix.ready.load(std::memory_order_acquire); }
         // A destructor
 		virtual ~UndirectedGraph() = default;
 	protected:
-		gSparse::SparsePrecisionMatrix _adjMatrix;        //!< adjacency matrix representation
-		gSparse::SparsePrecisionMatrix _degMatrix;        //!< degree matrix representation
-		gSparse::SparsePrecisionMatrix _incidentMatrix;   //!< incident matrix representation
-		gSparse::SparsePrecisionMatrix _weightMatrix;     //!< weight matrix representation
-        gSparse::SparsePrecisionMatrix _laplacianMatrix;  //!< laplacian matrix representation
+        //! A matrix representation built once, on first access
+        struct CachedMatrix
+        {
+            gSparse::SparsePrecisionMatrix matrix;  //!< the representation. Valid once ready is set.
+            std::atomic<bool> ready{false};         //!< whether matrix has been built
+            std::mutex mutex;                       //!< serializes building and releasing
+        };
+		mutable CachedMatrix _adjMatrix;        //!< adjacency matrix representation
+		mutable CachedMatrix _degMatrix;        //!< degree matrix representation
+		mutable CachedMatrix _incidentMatrix;   //!< incident matrix representation
+		mutable CachedMatrix _weightMatrix;     //!< weight matrix representation
+        mutable CachedMatrix _laplacianMatrix;  //!< laplacian matrix representation
 
-		gSparse::EdgeMatrix _edges;                        //!< edge list
-		gSparse::PrecisionRowMatrix _weights;                 //!< weight list
+		gSparse::EdgeMatrix _edges;                        //!< owned edge list. Empty when the graph wraps the caller's memory.
+		gSparse::PrecisionRowMatrix _weights;                 //!< owned weight list. Empty when the graph wraps the caller's memory.
+		gSparse::EdgeList _edgeList{nullptr, 0, 2};           //!< edge list, a view of _edges or of the caller's memory
+		gSparse::WeightList _weightList{nullptr, 0, 1};       //!< weight list, a view of _weights or of the caller's memory
 
 		std::size_t _edgeCount;                            //!< count of edges
 		std::size_t _nodeCount;                            //!< number of vertices
 	private:
+        typedef void (UndirectedGraph::*MatrixBuilder)(gSparse::SparsePrecisionMatrix &) const;
+
+        //! Return a cached matrix, building it first if needed. Concurrent callers build it only once.
+        inline const gSparse::SparsePrecisionMatrix & _cached(CachedMatrix & cache, MatrixBuilder build) const
+        {
+            if (!cache.ready.load(std::memory_order_acquire))
+            {
+                std::lock_guard<std::mutex> lock(cache.mutex);
+                if (!cache.ready.load(std::memory_order_relaxed))
+                {
+                    (this->*build)(cache.matrix);
+                    cache.ready.store(true, std::memory_order_release);
+                }
+            }
+            return cache.matrix;
+        }
+        //! Point a view at other memory. Assigning to an Eigen::Map would copy values instead.
+        template <typename MapType>
+        static inline void _rebind(MapType & map, const typename MapType::Scalar * data, Eigen::Index rows, Eigen::Index cols)
+        {
+            map.~MapType();
+            new (&map) MapType(data, rows, cols);
+        }
+        //! Move a cached matrix, leaving the source released
+        static inline void _move(CachedMatrix & to, CachedMatrix & from)
+        {
+            gSparse::SparsePrecisionMatrix().swap(to.matrix);
+            to.matrix.swap(from.matrix);
+            to.ready.store(from.ready.load(std::memory_order_acquire), std::memory_order_release);
+            from.ready.store(false, std::memory_order_release);
+        }
+        //! Free the memory of a cached matrix
+        static inline void _release(CachedMatrix & cache)
+        {
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            gSparse::SparsePrecisionMatrix().swap(cache.matrix);
+            cache.ready.store(false, std::memory_order_release);
+        }
         //! Private function to perform validate and build graph representations
 		virtual inline void _initializeSystem()
 		{
+			// Graphs that own their lists view them through _edgeList and _weightList
+			if (_edgeList.data() == nullptr && _edges.size() != 0)
+				_rebind(_edgeList, _edges.data(), _edges.rows(), _edges.cols());
+			if (_weightList.data() == nullptr && _weights.size() != 0)
+				_rebind(_weightList, _weights.data(), _weights.rows(), _weights.cols());
             #ifndef NDEBUG
                 // Enable input check only in DEBUG build
                 // Some of the checks are expensive such as checking minCoeff with O(n) runtime.
 			    _validateInput(); 
             #endif
-			_initializeMatrixSystem();
+			//Calculate counts. Matrix representations are built on demand.
+			_nodeCount = _edgeList.rows() == 0 ? 0 :
+				static_cast<std::size_t>(std::max(_edgeList.leftCols(1).maxCoeff(), _edgeList.rightCols(1).maxCoeff()) + 1);
+			_edgeCount = _edgeList.rows();
 		}
         //! validate preconditions
 		void inline _validateInput()
 		{
 			//There are more edges than weights
-			if (_edges.rows() != _weights.rows())
+			if (_edgeList.rows() != _weightList.rows())
 			{
 				std::stringstream ss;
-				ss << "UndirectedGraph: Edges.rows(): " << _edges.rows() << " =/= Weights.rows() " << _weights.rows() << std::endl;
+				ss << "UndirectedGraph: Edges.rows(): " << _edgeList.rows() << " =/= Weights.rows() " << _weightList.rows() << std::endl;
 				throw std::invalid_argument(ss.str());
 			}
-			if (_edges.cols() != 2)
+			if (_edgeList.cols() != 2)
 			{
 				std::stringstream ss;
 				ss << "UndirectedGraph: Edges.cols(): must equal to two" << std::endl;
 				throw std::invalid_argument(ss.str());
 			}
-			if (_weights.minCoeff() < 0)
+			if (_weightList.size() != 0 && _weightList.minCoeff() < 0)
 			{
 				std::stringstream ss;
 				ss << "UndirectedGraph: Weights must be greater than zero" << std::endl;
 				throw std::invalid_argument(ss.str());
 			}
 		}
-		//! Private function to create graph representation from edge and weight list
-		void inline _initializeMatrixSystem()
+		//! Build the symmetric adjacency matrix from edge and weight list
+		void inline _buildAdjacentMatrix(gSparse::SparsePrecisionMatrix & adjMatrix) const
 		{
-			//Calculate counts
-			_nodeCount = static_cast<std::size_t>(std::max(_edges.leftCols(1).maxCoeff(), _edges.rightCols(1).maxCoeff()) + 1);
-			_edgeCount = _edges.rows();
-
-			// Building Sparse Symmetric Adjacency Metric
 			std::vector<Eigen::Triplet<gSparse::PRECISION>> adjacentList;
-			std::vector<Eigen::Triplet<gSparse::PRECISION>> incidentList;
-			std::vector<Eigen::Triplet<gSparse::PRECISION>> weightList;
 			adjacentList.reserve(_edgeCount * 2);
-			incidentList.reserve(_edgeCount * 2);
-			weightList.reserve(_edgeCount);
-
+			for (std::size_t i = 0; i != _edgeCount; ++i)
+			{
+				std::size_t r = static_cast<std::size_t>(_edgeList(i, 0));
+				std::size_t c = static_cast<std::size_t>(_edgeList(i, 1));
+				adjacentList.push_back(Eigen::Triplet<gSparse::PRECISION>(r, c, _weightList(i, 0)));
+				adjacentList.push_back(Eigen::Triplet<gSparse::PRECISION>(c, r, _weightList(i, 0)));
+			}
+			adjMatrix = gSparse::SparsePrecisionMatrix(_nodeCount, _nodeCount);
+			adjMatrix.setFromTriplets(adjacentList.begin(), adjacentList.end());
+		}
+		//! Build the diagonal degree matrix from edge and weight list
+		void inline _buildDegreeMatrix(gSparse::SparsePrecisionMatrix & degMatrix) const
+		{
             // Vectorized Zero 
-			Eigen::VectorXd degVector = Eigen::VectorXd::Zero(_nodeCount);
-            
+			gSparse::PrecisionVector degVector = gSparse::PrecisionVector::Zero(_nodeCount);
 			for (std::size_t i = 0; i != _edgeCount; ++i)
 			{
-				std::size_t r = static_cast<std::size_t>(_edges(i, 0));
-				std::size_t c = static_cast<std::size_t>(_edges(i, 1));
-
-				//adjacent matrix
-				adjacentList.push_back(Eigen::Triplet<gSparse::PRECISION>(r, c, _weights(i, 0)));
-				adjacentList.push_back(Eigen::Triplet<gSparse::PRECISION>(c, r, _weights(i, 0)));
-
-				//degree matrix
-				degVector(r) += _weights(i, 0);
-				degVector(c) += _weights(i, 0);
-
-				//incident matrix
+				degVector(static_cast<std::size_t>(_edgeList(i, 0))) += _weightList(i, 0);
+				degVector(static_cast<std::size_t>(_edgeList(i, 1))) += _weightList(i, 0);
+			}
+			std::vector<Eigen::Triplet<gSparse::PRECISION>> degreeList;
+			degreeList.reserve(degVector.size());
+			for (int i = 0; i != degVector.size(); ++i)
+			{
+				degreeList.push_back(Eigen::Triplet<gSparse::PRECISION>(i, i, degVector(i)));
+			}
+			degMatrix = gSparse::SparsePrecisionMatrix(_nodeCount, _nodeCount);
+			degMatrix.setFromTriplets(degreeList.begin(), degreeList.end());
+		}
+		//! Build the edge-by-node incident matrix from edge list
+		void inline _buildIncidentMatrix(gSparse::SparsePrecisionMatrix & incidentMatrix) const
+		{
+			std::vector<Eigen::Triplet<gSparse::PRECISION>> incidentList;
+			incidentList.reserve(_edgeCount * 2);
+			for (std::size_t i = 0; i != _edgeCount; ++i)
+			{
+				std::size_t r = static_cast<std::size_t>(_edgeList(i, 0));
+				std::size_t c = static_cast<std::size_t>(_edgeList(i, 1));
 				if (r != c)
 				{
 					incidentList.push_back(Eigen::Triplet<gSparse::PRECISION>(i, r, 1));
 					incidentList.push_back(Eigen::Triplet<gSparse::PRECISION>(i, c, -1));
 				}
-				//Weight matrix
-				weightList.push_back(Eigen::Triplet<gSparse::PRECISION>(i, i, _weights(i)));
 			}
-			// Create adj matrix
-			_adjMatrix = gSparse::SparsePrecisionMatrix(_nodeCount, _nodeCount);
-			_adjMatrix.setFromTriplets(adjacentList.begin(), adjacentList.end());
-			
-			
-			std::vector<Eigen::Triplet<gSparse::PRECISION>> degreeList;
-			degreeList.reserve(degVector.size());
-			for (int i = 0; i != degVector.size(); ++i)
+			incidentMatrix = gSparse::SparsePrecisionMatrix(_edgeCount, _nodeCount);
+			incidentMatrix.setFromTriplets(incidentList.begin(), incidentList.end());
+		}
+		//! Build the diagonal weight matrix from weight list
+		void inline _buildWeightMatrix(gSparse::SparsePrecisionMatrix & weightMatrix) const
+		{
+			std::vector<Eigen::Triplet<gSparse::PRECISION>> weightList;
+			weightList.reserve(_edgeCount);
+			for (std::size_t i = 0; i != _edgeCount; ++i)
 			{
-				degreeList.push_back(Eigen::Triplet<gSparse::PRECISION>(i, i, degVector(i)));
+				weightList.push_back(Eigen::Triplet<gSparse::PRECISION>(i, i, _weightList(i)));
 			}
-			//Create degree matrix
-			_degMatrix = gSparse::SparsePrecisionMatrix(_nodeCount, _nodeCount);
-			_degMatrix.setFromTriplets(degreeList.begin(), degreeList.end());
-
-			//Create incident matrix
-			_incidentMatrix = gSparse::SparsePrecisionMatrix(_edgeCount, _nodeCount);
-			_incidentMatrix.setFromTriplets(incidentList.begin(), incidentList.end());
-			//Create weight matrix
-			_weightMatrix = gSparse::SparsePrecisionMatrix(_edgeCount, _edgeCount);
-			_weightMatrix.setFromTriplets(weightList.begin(), weightList.end());
-            //Create Laplacian matrix
-            _laplacianMatrix = _degMatrix - _adjMatrix; 
-			
+			weightMatrix = gSparse::SparsePrecisionMatrix(_edgeCount, _edgeCount);
+			weightMatrix.setFromTriplets(weightList.begin(), weightList.end());
+		}
+		//! Build the Laplacian matrix directly from edge and weight list, summing duplicate edges
+		void inline _buildLaplacianMatrix(gSparse::SparsePrecisionMatrix & laplacianMatrix) const
+		{
+			gSparse::Util::assembleLaplacian(_edgeList, _weightList, static_cast<Eigen::Index>(_nodeCount), laplacianMatrix);
 		}
 	};
 }
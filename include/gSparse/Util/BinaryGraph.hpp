@@ -0,0 +1,138 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_UTIL_BINARYGRAPH_HPP
+#define GSPARSE_UTIL_BINARYGRAPH_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>   // memcmp, memcpy
+#include <limits>
+
+#include <Eigen/Sparse>
+#include "../Config.hpp"
+
+namespace gSparse
+{
+    namespace Util
+    {
+        //! Header of a binary graph file, written by gSparse::GraphBinaryWriter.
+        /*!
+            A file is the 64-byte header followed by these sections. Each section starts at a multiple of 64 bytes:
+            - edges: edgeCount x 2 node indices of indexBytes each, row-major.
+            - weights: edgeCount values of scalarBytes each.
+            - Laplacian (if flags has LAPLACIAN): a compressed symmetric matrix, so its CSC and CSR arrays are the same.
+              (nodeCount + 1) outer offsets and laplacianNonZeros inner indices of storageIndexBytes each, then
+              laplacianNonZeros values of scalarBytes each.
+            - effective resistances (if flags has ER): edgeCount values of scalarBytes each.
+            Numbers are stored in the byte order of the writer. Readers reject files of the other byte order.
+        */
+        struct BinaryGraphHeader
+        {
+            char magic[8];                     //!< "gSparse" and a null character
+            std::uint32_t version;             //!< Format version, currently 1
+            std::uint32_t byteOrder;           //!< 0x01020304 in the byte order of the writer
+            std::uint32_t indexBytes;          //!< Size of a node index
+            std::uint32_t scalarBytes;         //!< Size of a weight: 4 for float, 8 for double
+            std::uint32_t storageIndexBytes;   //!< Size of a Laplacian outer offset or inner index
+            std::uint32_t flags;               //!< Optional sections present
+            std::uint64_t nodeCount;           //!< Number of nodes
+            std::uint64_t edgeCount;           //!< Number of edges
+            std::uint64_t laplacianNonZeros;   //!< Number of stored Laplacian entries
+            std::uint64_t reserved;            //!< Zero
+
+            enum { LAPLACIAN = 1, ER = 2 };
+
+            //! A header for the given sizes, with no optional section
+            static inline BinaryGraphHeader create(std::uint32_t indexBytes, std::uint32_t scalarBytes, std::uint32_t storageIndexBytes)
+            {
+                BinaryGraphHeader header;
+                std::memset(&header, 0, sizeof(header));
+                std::memcpy(header.magic, "gSparse", 8);
+                header.version = 1;
+                header.byteOrder = 0x01020304;
+                header.indexBytes = indexBytes;
+                header.scalarBytes = scalarBytes;
+                header.storageIndexBytes = storageIndexBytes;
+                return header;
+            }
+            //! Whether the header was written by a compatible writer
+            inline bool valid() const
+            {
+                return std::memcmp(magic, "gSparse", 8) == 0 && version == 1 && byteOrder == 0x01020304 &&
+                    (indexBytes == 4 || indexBytes == 8) && (scalarBytes == 4 || scalarBytes == 8) &&
+                    (storageIndexBytes == 4 || storageIndexBytes == 8);
+            }
+            //! Round a file offset up to the next section boundary
+            static inline std::uint64_t align(std::uint64_t offset) { return (offset + 63) / 64 * 64; }
+            //! File offset of the edge list
+            inline std::uint64_t edgeOffset() const { return align(sizeof(BinaryGraphHeader)); }
+            //! File offset of the weight list
+            inline std::uint64_t weightOffset() const { return align(edgeOffset() + edgeCount * 2 * indexBytes); }
+            //! File offset of the Laplacian outer offsets
+            inline std::uint64_t outerOffset() const { return align(weightOffset() + edgeCount * scalarBytes); }
+            //! File offset of the Laplacian inner indices
+            inline std::uint64_t innerOffset() const { return align(outerOffset() + (flags & LAPLACIAN ? (nodeCount + 1) * storageIndexBytes : 0)); }
+            //! File offset of the Laplacian values
+            inline std::uint64_t valueOffset() const { return align(innerOffset() + (flags & LAPLACIAN ? laplacianNonZeros * storageIndexBytes : 0)); }
+            //! File offset of the effective resistances
+            inline std::uint64_t erOffset() const { return align(valueOffset() + (flags & LAPLACIAN ? laplacianNonZeros * scalarBytes : 0)); }
+            //! Size of the whole file
+            inline std::uint64_t fileSize() const
+            {
+                if (flags & ER) return erOffset() + edgeCount * scalarBytes;
+                if (flags & LAPLACIAN) return valueOffset() + laplacianNonZeros * scalarBytes;
+                return weightOffset() + edgeCount * scalarBytes;
+            }
+        };
+        static_assert(sizeof(BinaryGraphHeader) == 64, "BinaryGraphHeader must be 64 bytes");
+
+        //! copyBinaryNumbers copies count stored numbers into out, converting them to T.
+        /*!
+        \param data: Start of the stored numbers.
+        \param count: Number of stored numbers.
+        \param bytes: Size of a stored number, 4 or 8.
+        \param real: Whether the stored numbers are float/double rather than unsigned integers.
+        \param out: Receives count numbers.
+        */
+        template <typename T>
+        inline void copyBinaryNumbers(const char * data, std::size_t count, std::uint32_t bytes, bool real, T * out)
+        {
+            if (bytes == sizeof(T) && real == !std::numeric_limits<T>::is_integer)
+            {
+                if (count != 0) std::memcpy(out, data, count * sizeof(T));
+                return;
+            }
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                const char * p = data + i * bytes;
+                if (real && bytes == 4) { float v; std::memcpy(&v, p, 4); out[i] = static_cast<T>(v); }
+                else if (real) { double v; std::memcpy(&v, p, 8); out[i] = static_cast<T>(v); }
+                else if (bytes == 4) { std::uint32_t v; std::memcpy(&v, p, 4); out[i] = static_cast<T>(v); }
+                else { std::uint64_t v; std::memcpy(&v, p, 8); out[i] = static_cast<T>(v); }
+            }
+        }
+
+        //! readBinaryLaplacian copies the Laplacian stored in a binary graph file, converting index and value sizes.
+        /*!
+        \param data: Start of the file.
+        \param header: The validated header of the file. Its LAPLACIAN flag must be set.
+        \param laplacian: Receives the Laplacian.
+        */
+        inline void readBinaryLaplacian(const char * data, const BinaryGraphHeader & header,
+            gSparse::SparsePrecisionMatrix & laplacian)
+        {
+            const Eigen::Index n = static_cast<Eigen::Index>(header.nodeCount);
+            const std::size_t nonZeros = static_cast<std::size_t>(header.laplacianNonZeros);
+            laplacian.resize(n, n);
+            laplacian.resizeNonZeros(static_cast<Eigen::Index>(nonZeros));
+            copyBinaryNumbers(data + header.outerOffset(), static_cast<std::size_t>(n) + 1,
+                header.storageIndexBytes, false, laplacian.outerIndexPtr());
+            copyBinaryNumbers(data + header.innerOffset(), nonZeros, header.storageIndexBytes, false, laplacian.innerIndexPtr());
+            copyBinaryNumbers(data + header.valueOffset(), nonZeros, header.scalarBytes, true, laplacian.valuePtr());
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,116 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_UTIL_BUFFEREDWRITER_HPP
+#define GSPARSE_UTIL_BUFFEREDWRITER_HPP
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <cstddef>
+#include <cstring>     // memcpy
+
+#include "CSVFormatter.hpp"  // Number formatting
+
+namespace gSparse
+{
+    namespace Util
+    {
+        //! A text file written through large buffers.
+        /*!
+            Text is formatted into a buffer of about 1 MiB, which is written to the file in one call when full.
+            With background writing, a second buffer is filled while a thread writes the first.
+        */
+        class BufferedWriter
+        {
+        public:
+            //! Constructor
+            /*!
+            \param path: File to create or truncate.
+            \param background: Whether a thread writes full buffers. Default is false.
+            */
+            BufferedWriter(const std::string & path, bool background = false) :
+                _file(path.c_str(), std::ios::binary | std::ios::trunc),
+                _background(background)
+            {
+                _buffers[0].resize(_capacity);
+                if (_background) _buffers[1].resize(_capacity);
+            }
+            BufferedWriter(const BufferedWriter &) = delete;
+            BufferedWriter & operator=(const BufferedWriter &) = delete;
+            ~BufferedWriter() { if (_writer.joinable()) _writer.join(); }
+
+            //! Whether the file was opened
+            inline bool is_open() const { return _file.is_open(); }
+            //! Make room for chars characters and return where they go. Call commit once they are written.
+            inline char * reserve(std::size_t chars)
+            {
+                if (_used + chars > _buffers[_current].size())
+                {
+                    _flush();
+                    if (chars > _buffers[_current].size()) _buffers[_current].resize(chars);
+                }
+                return _buffers[_current].data() + _used;
+            }
+            //! Keep the characters written up to end, a pointer into the last reserved space
+            inline void commit(const char * end) { _used = static_cast<std::size_t>(end - _buffers[_current].data()); }
+            //! Append text
+            inline void write(const char * text, std::size_t length)
+            {
+                char * p = reserve(length);
+                std::memcpy(p, text, length);
+                commit(p + length);
+            }
+            //! Append text
+            inline void write(const std::string & text) { write(text.data(), text.size()); }
+            //! Append a number formatted by gSparse::Util::formatNumber
+            template <typename T>
+            inline void writeNumber(T value)
+            {
+                char * p = reserve(MAX_NUMBER_CHARS);
+                commit(p + formatNumber(p, value));
+            }
+            //! Write the remaining text and close the file. Returns false if any write failed.
+            inline bool close()
+            {
+                _flush();
+                if (_writer.joinable()) _writer.join();
+                _file.close();
+                return !_file.fail();
+            }
+        private:
+            std::ofstream _file;              //!< Output file
+            bool _background;                 //!< Whether a thread writes full buffers
+            std::vector<char> _buffers[2];    //!< Buffer being filled, and buffer being written in the background
+            std::size_t _current = 0;         //!< Index of the buffer being filled
+            std::size_t _used = 0;            //!< Characters in the buffer being filled
+            std::thread _writer;              //!< Thread writing the other buffer
+            static const std::size_t _capacity = 1 << 20;  //!< Initial size of a buffer
+
+            //! Write the buffer being filled
+            inline void _flush()
+            {
+                if (_used == 0) return;
+                const char * data = _buffers[_current].data();
+                const std::streamsize size = static_cast<std::streamsize>(_used);
+                if (_background)
+                {
+                    // The other buffer is free once its write is done
+                    if (_writer.joinable()) _writer.join();
+                    std::ofstream * file = &_file;
+                    _writer = std::thread([file, data, size]() { file->write(data, size); });
+                    _current ^= 1;
+                    if (_buffers[_current].size() < _buffers[_current ^ 1].size())
+                        _buffers[_current].resize(_buffers[_current ^ 1].size());
+                }
+                else
+                    _file.write(data, size);
+                _used = 0;
+            }
+        };
+    }
+}
+
+#endif
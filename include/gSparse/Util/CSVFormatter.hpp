@@ -0,0 +1,377 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_UTIL_CSVFORMATTER_HPP
+#define GSPARSE_UTIL_CSVFORMATTER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <cstring>     // memcpy
+#include <limits>
+#include <type_traits>
+#include <vector>      // Big integers for the power of ten table
+
+namespace gSparse
+{
+    namespace Util
+    {
+        //! Longest text formatNumber writes for one number
+        enum { MAX_NUMBER_CHARS = 32 };
+
+        //! formatNumber writes an integer in decimal.
+        /*!
+        \param out: Receives the digits. Must hold MAX_NUMBER_CHARS characters.
+        \param value: The number.
+        \return Number of characters written.
+        */
+        template <typename T>
+        inline typename std::enable_if<std::is_integral<T>::value, std::size_t>::type
+        formatNumber(char * out, T value)
+        {
+            static const char pairs[] =
+                "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                "8081828384858687888990919293949596979899";
+            std::size_t length = 0;
+            typedef typename std::make_unsigned<T>::type Unsigned;
+            Unsigned v = static_cast<Unsigned>(value);
+            if (value < 0)
+            {
+                out[length++] = '-';
+                v = static_cast<Unsigned>(0) - v;
+            }
+            // Digits are produced two at a time from the right
+            char digits[24];
+            char * p = digits + sizeof(digits);
+            while (v >= 100)
+            {
+                const unsigned pair = static_cast<unsigned>(v % 100) * 2;
+                v /= 100;
+                *--p = pairs[pair + 1];
+                *--p = pairs[pair];
+            }
+            if (v >= 10)
+            {
+                *--p = pairs[v * 2 + 1];
+                *--p = pairs[v * 2];
+            }
+            else
+                *--p = static_cast<char>('0' + v);
+            const std::size_t count = static_cast<std::size_t>(digits + sizeof(digits) - p);
+            std::memcpy(out + length, p, count);
+            return length + count;
+        }
+
+        namespace Detail
+        {
+            //! A floating point number f * 2^e with a 64-bit significand, as in Grisu (Loitsch, PLDI 2010)
+            struct DiyFp
+            {
+                std::uint64_t f;
+                int e;
+                DiyFp(std::uint64_t f_ = 0, int e_ = 0) : f(f_), e(e_) {}
+                //! x - y for x.e == y.e and x.f >= y.f
+                static inline DiyFp sub(const DiyFp & x, const DiyFp & y) { return DiyFp(x.f - y.f, x.e); }
+                //! x * y rounded to 64 bits
+                static inline DiyFp mul(const DiyFp & x, const DiyFp & y)
+                {
+                    const std::uint64_t xLo = x.f & 0xFFFFFFFFu, xHi = x.f >> 32;
+                    const std::uint64_t yLo = y.f & 0xFFFFFFFFu, yHi = y.f >> 32;
+                    const std::uint64_t p0 = xLo * yLo, p1 = xLo * yHi, p2 = xHi * yLo, p3 = xHi * yHi;
+                    std::uint64_t q = (p0 >> 32) + (p1 & 0xFFFFFFFFu) + (p2 & 0xFFFFFFFFu);
+                    q += std::uint64_t(1) << 31;
+                    return DiyFp(p3 + (p1 >> 32) + (p2 >> 32) + (q >> 32), x.e + y.e + 64);
+                }
+                //! Shift the significand left until its top bit is set
+                static inline DiyFp normalize(DiyFp x)
+                {
+                    while ((x.f >> 63) == 0) { x.f <<= 1; --x.e; }
+                    return x;
+                }
+            };
+
+            //! 10^k ~ f * 2^e with f normalized, for k = -300, -292, ..., 324
+            struct CachedPower { std::uint64_t f; int e; int k; };
+            enum { CACHED_POWER_MIN_EXP = -300, CACHED_POWER_STEP = 8, CACHED_POWER_COUNT = 79 };
+
+            //! Compute the cached powers of ten exactly with big integers
+            inline const CachedPower * cachedPowers()
+            {
+                struct Table
+                {
+                    CachedPower powers[CACHED_POWER_COUNT];
+                    // Little-endian base 2^32 integers
+                    typedef std::vector<std::uint32_t> Big;
+                    static void mulSmall(Big & x, std::uint32_t m)
+                    {
+                        std::uint64_t carry = 0;
+                        for (std::uint32_t & word : x)
+                        {
+                            const std::uint64_t v = std::uint64_t(word) * m + carry;
+                            word = static_cast<std::uint32_t>(v);
+                            carry = v >> 32;
+                        }
+                        if (carry) x.push_back(static_cast<std::uint32_t>(carry));
+                    }
+                    static int bitLength(const Big & x)
+                    {
+                        int bits = static_cast<int>(x.size()) * 32;
+                        for (std::uint32_t top = x.back(); (top & 0x80000000u) == 0; top <<= 1) --bits;
+                        return bits;
+                    }
+                    static int bit(const Big & x, int i) { return static_cast<int>((x[i / 32] >> (i % 32)) & 1u); }
+                    static bool lessThan(const Big & x, const Big & y)
+                    {
+                        if (x.size() != y.size()) return x.size() < y.size();
+                        for (std::size_t i = x.size(); i-- != 0; )
+                            if (x[i] != y[i]) return x[i] < y[i];
+                        return false;
+                    }
+                    static void subtract(Big & x, const Big & y)
+                    {
+                        std::int64_t borrow = 0;
+                        for (std::size_t i = 0; i != x.size(); ++i)
+                        {
+                            std::int64_t v = std::int64_t(x[i]) - (i < y.size() ? std::int64_t(y[i]) : 0) - borrow;
+                            borrow = v < 0;
+                            x[i] = static_cast<std::uint32_t>(v + (borrow ? (std::int64_t(1) << 32) : 0));
+                        }
+                        while (x.size() > 1 && x.back() == 0) x.pop_back();
+                    }
+                    static void doubled(Big & x)
+                    {
+                        std::uint32_t carry = 0;
+                        for (std::uint32_t & word : x)
+                        {
+                            const std::uint32_t next = word >> 31;
+                            word = (word << 1) | carry;
+                            carry = next;
+                        }
+                        if (carry) x.push_back(carry);
+                    }
+                    //! Round a 65-bit value given as its top 64 bits and the bit below to 64 bits
+                    static void round(std::uint64_t & f, int & e, int below)
+                    {
+                        if (below && ++f == 0) { f = std::uint64_t(1) << 63; ++e; }
+                    }
+                    Table()
+                    {
+                        for (int i = 0; i != CACHED_POWER_COUNT; ++i)
+                        {
+                            const int k = CACHED_POWER_MIN_EXP + i * CACHED_POWER_STEP;
+                            const int m = k < 0 ? -k : k;
+                            Big five(1, 1);
+                            for (int j = 0; j != m; ++j) mulSmall(five, 5);
+                            std::uint64_t f = 0;
+                            int e = 0;
+                            if (k >= 0)
+                            {
+                                // 10^k = 5^k * 2^k
+                                const int length = bitLength(five);
+                                for (int j = 0; j != 64; ++j)
+                                    f = (f << 1) | static_cast<std::uint64_t>(length - 1 - j >= 0 ? bit(five, length - 1 - j) : 0);
+                                e = length - 64 + k;
+                                round(f, e, length - 65 >= 0 ? bit(five, length - 65) : 0);
+                            }
+                            else
+                            {
+                                // 10^k = 2^k / 5^m by binary long division of 1 by 5^m
+                                Big remainder(1, 1);
+                                int position = 0;
+                                int collected = 0;
+                                int below = 0;
+                                while (collected != 65)
+                                {
+                                    doubled(remainder);
+                                    ++position;
+                                    int digit = 0;
+                                    if (!lessThan(remainder, five)) { subtract(remainder, five); digit = 1; }
+                                    if (collected == 0 && digit == 0) continue;
+                                    if (collected < 64) f = (f << 1) | static_cast<std::uint64_t>(digit);
+                                    else below = digit;
+                                    if (collected == 0) e = -position - 63 + k;
+                                    ++collected;
+                                }
+                                round(f, e, below);
+                            }
+                            powers[i].f = f;
+                            powers[i].e = e;
+                            powers[i].k = k;
+                        }
+                    }
+                };
+                static const Table table;
+                return table.powers;
+            }
+
+            //! Shorten the last digit towards w while it stays within the rounding interval
+            inline void grisuRound(char * buffer, int length, std::uint64_t distance, std::uint64_t delta,
+                std::uint64_t rest, std::uint64_t tenK)
+            {
+                while (rest < distance && delta - rest >= tenK &&
+                    (rest + tenK < distance || distance - rest > rest + tenK - distance))
+                {
+                    --buffer[length - 1];
+                    rest += tenK;
+                }
+            }
+
+            //! Grisu2: the digits of a decimal in (minus, plus) close to v, with few digits
+            /*!
+                The result always reads back as v, and is the shortest such decimal for almost every v.
+            \param buffer: Receives the digits, at most 17.
+            \param length: Receives the number of digits.
+            \param exponent: Receives the power of ten of the last digit.
+            */
+            template <typename T>
+            inline void grisu2(char * buffer, int & length, int & exponent, T value)
+            {
+                // Boundaries of the values that round to value, in the format of T
+                const int precision = std::numeric_limits<T>::digits;
+                const int bias = std::numeric_limits<T>::max_exponent - 1 + (precision - 1);
+                const std::uint64_t hidden = std::uint64_t(1) << (precision - 1);
+                typedef typename std::conditional<sizeof(T) == 4, std::uint32_t, std::uint64_t>::type Bits;
+                Bits bits;
+                std::memcpy(&bits, &value, sizeof(T));
+                const std::uint64_t F = bits & (hidden - 1);
+                const std::uint64_t E = static_cast<std::uint64_t>(bits) >> (precision - 1);
+                const DiyFp v = E == 0 ? DiyFp(F, 1 - bias) : DiyFp(F + hidden, static_cast<int>(E) - bias);
+                const bool lowerCloser = F == 0 && E > 1;
+                const DiyFp plus = DiyFp::normalize(DiyFp(2 * v.f + 1, v.e - 1));
+                DiyFp minus = lowerCloser ? DiyFp(4 * v.f - 1, v.e - 2) : DiyFp(2 * v.f - 1, v.e - 1);
+                minus = DiyFp(minus.f << (minus.e - plus.e), plus.e);
+                const DiyFp w = DiyFp::normalize(v);
+                const DiyFp wNormalized(w.f << (w.e - plus.e), plus.e);
+
+                // Scale by a cached power of ten so that the exponent lands in [-60, -32]
+                const int f = -60 - plus.e - 1;
+                const int k = f * 78913 / (1 << 18) + (f > 0);
+                const int index = (-CACHED_POWER_MIN_EXP + k + (CACHED_POWER_STEP - 1)) / CACHED_POWER_STEP;
+                const CachedPower & cached = cachedPowers()[index];
+                const DiyFp c(cached.f, cached.e);
+                const DiyFp W = DiyFp::mul(wNormalized, c);
+                const DiyFp wMinus = DiyFp::mul(minus, c);
+                const DiyFp wPlus = DiyFp::mul(plus, c);
+                const DiyFp Mminus(wMinus.f + 1, wMinus.e);
+                const DiyFp Mplus(wPlus.f - 1, wPlus.e);
+                exponent = -cached.k;
+
+                // Generate digits of Mplus until the rest fits in the interval
+                std::uint64_t delta = DiyFp::sub(Mplus, Mminus).f;
+                std::uint64_t distance = DiyFp::sub(Mplus, W).f;
+                const DiyFp one(std::uint64_t(1) << -Mplus.e, Mplus.e);
+                std::uint32_t p1 = static_cast<std::uint32_t>(Mplus.f >> -one.e);
+                std::uint64_t p2 = Mplus.f & (one.f - 1);
+                std::uint32_t pow10 = 1000000000;
+                int n = 10;
+                while (n > 1 && p1 < pow10) { pow10 /= 10; --n; }
+                length = 0;
+                while (n > 0)
+                {
+                    buffer[length++] = static_cast<char>('0' + p1 / pow10);
+                    p1 %= pow10;
+                    --n;
+                    const std::uint64_t rest = (std::uint64_t(p1) << -one.e) + p2;
+                    if (rest <= delta)
+                    {
+                        exponent += n;
+                        grisuRound(buffer, length, distance, delta, rest, std::uint64_t(pow10) << -one.e);
+                        return;
+                    }
+                    pow10 /= 10;
+                }
+                int m = 0;
+                for (;;)
+                {
+                    p2 *= 10;
+                    buffer[length++] = static_cast<char>('0' + (p2 >> -one.e));
+                    p2 &= one.f - 1;
+                    ++m;
+                    delta *= 10;
+                    distance *= 10;
+                    if (p2 <= delta) break;
+                }
+                exponent -= m;
+                grisuRound(buffer, length, distance, delta, p2, one.f);
+            }
+        }
+
+        //! formatNumber writes a short decimal number that reads back exactly as value.
+        /*!
+            Digits come from Grisu2, which gives the shortest such decimal for almost every value without big integer
+            arithmetic. Numbers from 1e-4 up to 1e(digits10 + 2) are written without an exponent, and output never
+            depends on the C locale.
+        \param out: Receives the number. Must hold MAX_NUMBER_CHARS characters.
+        \param value: The number.
+        \return Number of characters written.
+        */
+        template <typename T>
+        inline typename std::enable_if<std::is_floating_point<T>::value, std::size_t>::type
+        formatNumber(char * out, T value)
+        {
+            static_assert(std::numeric_limits<T>::is_iec559 && (sizeof(T) == 4 || sizeof(T) == 8),
+                "formatNumber: only IEEE float and double are supported");
+            if (std::isnan(value)) { std::memcpy(out, "nan", 3); return 3; }
+            std::size_t length = 0;
+            if (std::signbit(value))
+            {
+                out[length++] = '-';
+                value = -value;
+            }
+            if (std::isinf(value)) { std::memcpy(out + length, "inf", 3); return length + 3; }
+            if (value == 0) { out[length++] = '0'; return length; }
+
+            char digits[20];
+            int count = 0;
+            int exponent = 0;
+            Detail::grisu2(digits, count, exponent, value);
+            // value = digits * 10^exponent = 0.digits * 10^point
+            const int point = count + exponent;
+            char * p = out + length;
+            if (count <= point && point <= std::numeric_limits<T>::digits10 + 2)
+            {
+                // dddd00
+                std::memcpy(p, digits, static_cast<std::size_t>(count));
+                std::memset(p + count, '0', static_cast<std::size_t>(point - count));
+                return length + static_cast<std::size_t>(point);
+            }
+            if (0 < point && point <= std::numeric_limits<T>::digits10 + 2)
+            {
+                // dd.dd
+                std::memcpy(p, digits, static_cast<std::size_t>(point));
+                p[point] = '.';
+                std::memcpy(p + point + 1, digits + point, static_cast<std::size_t>(count - point));
+                return length + static_cast<std::size_t>(count + 1);
+            }
+            if (-4 < point && point <= 0)
+            {
+                // 0.000dd
+                p[0] = '0';
+                p[1] = '.';
+                std::memset(p + 2, '0', static_cast<std::size_t>(-point));
+                std::memcpy(p + 2 - point, digits, static_cast<std::size_t>(count));
+                return length + static_cast<std::size_t>(2 - point + count);
+            }
+            // d.dde+XX
+            std::size_t written = 0;
+            p[written++] = digits[0];
+            if (count > 1)
+            {
+                p[written++] = '.';
+                std::memcpy(p + written, digits + 1, static_cast<std::size_t>(count - 1));
+                written += static_cast<std::size_t>(count - 1);
+            }
+            int e = point - 1;
+            p[written++] = 'e';
+            p[written++] = e < 0 ? '-' : '+';
+            if (e < 0) e = -e;
+            if (e < 10) p[written++] = '0';
+            written += formatNumber(p + written, e);
+            return length + written;
+        }
+    }
+}
+
+#endif
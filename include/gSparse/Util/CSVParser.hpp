@@ -0,0 +1,296 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_UTIL_CSVPARSER_HPP
+#define GSPARSE_UTIL_CSVPARSER_HPP
+
+#include <cstdlib>     // strtod
+#include <cmath>       // floor
+#include <cstdint>
+#include <cstddef>
+#include <cstring>     // memchr
+#include <string>
+#include <limits>
+#include <type_traits>
+
+namespace gSparse
+{
+    namespace Util
+    {
+        //! Characters that end a CSV cell besides the delimiter
+        inline bool isCellEnd(char c, char delimiter)
+        {
+            return c == delimiter || c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        //! parseNumber parses a decimal floating point number at the start of [cursor, end).
+        /*!
+            Numbers with at most 19 significant digits and a power of ten of at most 22 are converted exactly with one
+            multiplication or division in double precision (Clinger's fast path). Anything else, including inf and nan,
+            falls back to std::strtod.
+        \param cursor: Start of the number. Moved past the number on success.
+        \param end: End of the input.
+        \param delimiter: Cell delimiter.
+        \param value: Receives the number.
+        \return false if no number starts at cursor.
+        */
+        inline bool parseNumber(const char *& cursor, const char * end, char delimiter, double & value)
+        {
+            static const double powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+            const char * p = cursor;
+            bool negative = false;
+            if (p != end && (*p == '-' || *p == '+')) negative = (*p++ == '-');
+
+            std::uint64_t mantissa = 0;
+            int digits = 0;        // significant digits in mantissa
+            int exponent = 0;      // power of ten applied to mantissa
+            bool anyDigit = false;
+            bool exact = true;
+            for (; p != end && *p >= '0' && *p <= '9'; ++p)
+            {
+                anyDigit = true;
+                if (digits < 19) { mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0'); if (mantissa) ++digits; }
+                else { ++exponent; exact = false; }
+            }
+            if (p != end && *p == '.')
+            {
+                for (++p; p != end && *p >= '0' && *p <= '9'; ++p)
+                {
+                    anyDigit = true;
+                    if (digits < 19) { mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0'); if (mantissa) ++digits; --exponent; }
+                    else exact = false;
+                }
+            }
+            if (anyDigit && p != end && (*p == 'e' || *p == 'E'))
+            {
+                const char * q = p + 1;
+                bool negativeExponent = false;
+                if (q != end && (*q == '-' || *q == '+')) negativeExponent = (*q++ == '-');
+                if (q != end && *q >= '0' && *q <= '9')
+                {
+                    int e = 0;
+                    for (; q != end && *q >= '0' && *q <= '9'; ++q)
+                        if (e < 100000) e = e * 10 + (*q - '0');
+                    exponent += negativeExponent ? -e : e;
+                    p = q;
+                }
+            }
+
+            if (anyDigit && exact && mantissa <= (std::uint64_t(1) << 53) && exponent >= -22 && exponent <= 22 &&
+                (p == end || isCellEnd(*p, delimiter)))
+            {
+                // Both the mantissa and the power of ten are exact doubles, so one rounding gives the nearest double
+                double result = static_cast<double>(mantissa);
+                result = exponent < 0 ? result / powers[-exponent] : result * powers[exponent];
+                value = negative ? -result : result;
+                cursor = p;
+                return true;
+            }
+
+            // Slow path on a null-terminated copy of the cell
+            const char * cellEnd = cursor;
+            while (cellEnd != end && !isCellEnd(*cellEnd, delimiter)) ++cellEnd;
+            if (cellEnd == cursor) return false;
+            std::string cell(cursor, cellEnd);
+            char * parsedEnd = nullptr;
+            value = std::strtod(cell.c_str(), &parsedEnd);
+            if (parsedEnd != cell.c_str() + cell.size()) return false;
+            cursor = cellEnd;
+            return true;
+        }
+
+        //! parseNumber parses an unsigned integer at the start of [cursor, end).
+        /*!
+            Cells written as floating point numbers with an integral value, such as 3.0, are parsed as double and converted.
+        \return false if no number starts at cursor, if it is not an integer, or if it does not fit in T.
+        */
+        template <typename T>
+        inline typename std::enable_if<std::is_integral<T>::value, bool>::type
+        parseNumber(const char *& cursor, const char * end, char delimiter, T & value)
+        {
+            const char * p = cursor;
+            const std::uint64_t maximum = static_cast<std::uint64_t>(std::numeric_limits<T>::max());
+            std::uint64_t result = 0;
+            for (; p != end && *p >= '0' && *p <= '9'; ++p)
+            {
+                // Checked before multiplying, as result * 10 + digit may wrap around for 64-bit T
+                const unsigned digit = static_cast<unsigned>(*p - '0');
+                if (result > (maximum - digit) / 10) return false;
+                result = result * 10 + digit;
+            }
+            if (p != cursor && (p == end || isCellEnd(*p, delimiter)))
+            {
+                value = static_cast<T>(result);
+                cursor = p;
+                return true;
+            }
+            double real;
+            if (!parseNumber(cursor, end, delimiter, real)) return false;
+            // The upper bound is exclusive, as max() of a 64-bit T rounds up to a power of two in double
+            if (!(real >= static_cast<double>(std::numeric_limits<T>::lowest()) &&
+                  real < static_cast<double>(std::numeric_limits<T>::max()) + 1.0)) return false;
+            if (real != std::floor(real)) return false;
+            value = static_cast<T>(real);
+            return true;
+        }
+
+        //! parseNumber parses a floating point number of any precision, through double.
+        template <typename T>
+        inline typename std::enable_if<std::is_floating_point<T>::value && !std::is_same<T, double>::value, bool>::type
+        parseNumber(const char *& cursor, const char * end, char delimiter, T & value)
+        {
+            double real;
+            if (!parseNumber(cursor, end, delimiter, real)) return false;
+            value = static_cast<T>(real);
+            return true;
+        }
+
+        //! parseCSVRow parses one line of delimited numbers.
+        /*!
+            Spaces and tabs around cells are ignored. With a space or tab delimiter, a run of blanks separates two cells.
+        \param cursor: Start of the line. Moved to the start of the next line.
+        \param end: End of the input.
+        \param delimiter: Cell delimiter.
+        \param out: Receives the cells. May be nullptr to only count them.
+        \param capacity: Maximum number of cells to write to out.
+        \return Number of cells in the line, or -1 if a cell is not a number or the line has more than capacity cells.
+        */
+        template <typename Scalar>
+        inline long parseCSVRow(const char *& cursor, const char * end, char delimiter, Scalar * out, std::size_t capacity)
+        {
+            const char * p = cursor;
+            long count = 0;
+            for (;;)
+            {
+                while (p != end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+                if (p == end || *p == '\n') break;
+                Scalar value;
+                if (!parseNumber(p, end, delimiter, value)) return -1;
+                if (out != nullptr)
+                {
+                    if (static_cast<std::size_t>(count) == capacity) return -1;
+                    out[count] = value;
+                }
+                ++count;
+                while (p != end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+                if (p != end && *p == delimiter) ++p;
+            }
+            cursor = (p == end) ? end : p + 1;
+            return count;
+        }
+
+        //! skipBlanks moves cursor past spaces, tabs and carriage returns, stopping at a newline.
+        inline void skipBlanks(const char *& cursor, const char * end)
+        {
+            while (cursor != end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) ++cursor;
+        }
+
+        //! atLineEnd skips blanks and returns whether cursor reached the end of its line.
+        inline bool atLineEnd(const char *& cursor, const char * end)
+        {
+            skipBlanks(cursor, end);
+            return cursor == end || *cursor == '\n';
+        }
+
+        //! skipLine moves cursor to the start of the next line.
+        inline void skipLine(const char *& cursor, const char * end)
+        {
+            const void * newline = std::memchr(cursor, '\n', static_cast<std::size_t>(end - cursor));
+            cursor = newline == nullptr ? end : static_cast<const char *>(newline) + 1;
+        }
+
+        //! readNumber skips blanks, then parses a number that ends at a blank or the end of the line.
+        template <typename T>
+        inline bool readNumber(const char *& cursor, const char * end, T & value)
+        {
+            skipBlanks(cursor, end);
+            return parseNumber(cursor, end, ' ', value);
+        }
+
+        //! nextDataLine moves cursor to the first number of the next line that is neither blank nor a comment.
+        /*!
+        \param cursor: Start of a line.
+        \param end: End of the input.
+        \param comment: Character that starts a comment line, such as '#' or '%'.
+        \return false if no such line remains.
+        */
+        inline bool nextDataLine(const char *& cursor, const char * end, char comment)
+        {
+            while (cursor != end)
+            {
+                if (atLineEnd(cursor, end) || *cursor == comment) skipLine(cursor, end);
+                else return true;
+            }
+            return false;
+        }
+
+        //! countCSVColumns counts the cells in the first non-blank line of [begin, end).
+        /*!
+        \return Number of cells, 0 if every line is blank, or -1 if a cell is not a number.
+        */
+        template <typename Scalar>
+        inline long countCSVColumns(const char * begin, const char * end, char delimiter)
+        {
+            const char * cursor = begin;
+            long count = 0;
+            while (count == 0 && cursor != end)
+                count = parseCSVRow<Scalar>(cursor, end, delimiter, nullptr, 0);
+            return count;
+        }
+
+        //! countLines counts the lines of [begin, end). A last line without a newline counts too.
+        inline std::size_t countLines(const char * begin, const char * end)
+        {
+            std::size_t count = 0;
+            const char * p = begin;
+            while (p != end)
+            {
+                const void * newline = std::memchr(p, '\n', static_cast<std::size_t>(end - p));
+                ++count;
+                if (newline == nullptr) break;
+                p = static_cast<const char *>(newline) + 1;
+            }
+            return count;
+        }
+
+        //! parseCSVRows parses lines of delimited numbers into a row-major array.
+        /*!
+            Blank lines are skipped.
+        \param begin: Start of the first line.
+        \param end: End of the input.
+        \param delimiter: Cell delimiter.
+        \param cols: Number of cells every line must have.
+        \param out: Receives rows * cols cells.
+        \param capacity: Maximum number of rows to write.
+        \param error: Receives the start of the first malformed line, or nullptr.
+        \return Number of rows written.
+        */
+        template <typename Scalar>
+        inline std::size_t parseCSVRows(const char * begin, const char * end, char delimiter, std::size_t cols,
+            Scalar * out, std::size_t capacity, const char *& error)
+        {
+            error = nullptr;
+            std::size_t rows = 0;
+            const char * cursor = begin;
+            while (cursor != end)
+            {
+                const char * line = cursor;
+                if (rows == capacity)
+                {
+                    // Only blank lines may remain
+                    if (parseCSVRow<Scalar>(cursor, end, delimiter, nullptr, 0) != 0) { error = line; break; }
+                    continue;
+                }
+                long count = parseCSVRow(cursor, end, delimiter, out + rows * cols, cols);
+                if (count == 0) continue;
+                if (count != static_cast<long>(cols)) { error = line; break; }
+                ++rows;
+            }
+            return rows;
+        }
+    }
+}
+
+#endif
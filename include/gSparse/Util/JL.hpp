@@ -6,24 +6,53 @@
 #define GSPARSE_UTIL_JL_HPP
 
 #include "../Config.hpp"
+#include "Random.hpp"  // Counter-based random numbers
 #include <Eigen/Dense>
 
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
 namespace gSparse
 {
     namespace Util
     {
+        //! implicitProjectionEntry returns an entry of an implicit JL projection matrix.
+        /*!
+            Entries are generated on the fly from a counter-based random number generator keyed by
+            (seed, row, col). The same arguments always return the same value.
+        \param row: Row of the entry.
+        \param col: Column of the entry.
+        \param scale: square root of Scale will divide the value of the JL Matrix.
+        \param tolProb: Tolerance threshold value between 0.0 and 1.0. Higher tolerance means less likely to get positive entry.
+        \param seed: Seed identifying the projection matrix.
+        */
+        inline gSparse::PRECISION
+            implicitProjectionEntry(std::size_t row,
+                std::size_t col,
+                double scale,
+                double tolProb,
+                std::uint64_t seed)
+        {
+            double x = gSparse::Util::toUniform(
+                gSparse::Util::counterHash(seed ^ (static_cast<std::uint64_t>(row) * 0xD1B54A32D192ED03ULL), col));
+            return x > tolProb ? 1.0 / std::sqrt(scale) : -1.0 / std::sqrt(scale);
+        }
+
         //! randomProjectionMatrix creates a Johnson-Lindenstrauss lemma projection matrix.
         /*!
         \param rows: Number of rows for generated matrix.
         \param cols: Number of columns for generated matrix.
         \param scale: square root of Scale will divide the value of the JL Matrix. Default is 1.0.
         \param tolProb: Tolerance threshold value between 0.0 and 1.0. Higher tolerance means less likely to get positive matrix. Default is 0.5.
+        \param seed: Seed of the matrix. Entries are those of implicitProjectionEntry. Default is gSparse::Util::nextSeed().
         */
 		inline gSparse::PrecisionMatrix
 		    randomProjectionMatrix(std::size_t rows,
 				std::size_t cols,
 				double scale = 1.0f,
-				double tolProb = 0.5f)
+				double tolProb = 0.5f,
+				std::uint64_t seed = gSparse::Util::nextSeed())
 		{
 			#ifndef NDEBUG
                 assert (tolProb <= 1.0f);  
@@ -33,16 +62,65 @@ namespace gSparse
                 assert (cols > 0 ); 
             #endif 
 
-            gSparse::PrecisionMatrix result =
-				(gSparse::PrecisionMatrix::Random(rows, cols).array() + 1.0) / 2.0;
-            
-			result = result.unaryExpr([=](gSparse::PRECISION x)
+            gSparse::PrecisionMatrix result(rows, cols);
+			for (std::size_t j = 0; j != cols; ++j)
 			{
-				return x > tolProb ? 1.0 / sqrt(scale) : -1.0 / std::sqrt(scale);
-			});
+				for (std::size_t i = 0; i != rows; ++i)
+					result(i, j) = implicitProjectionEntry(i, j, scale, tolProb, seed);
+			}
             // Copy elision will optimize return by value.
 			return result;
 		}
+
+        //! implicitProjection applies an implicit JL projection to a graph without materializing it.
+        /*!
+            Computes Y = B^T * W^(1/2) * Q^T where B is the (m x n) incident matrix, W the weight matrix
+            and Q a (rows x m) JL projection matrix whose entries are given by implicitProjectionEntry.
+            Runs in O(rows * m) time with O(rows * n) memory.
+        \param edges: Edge list of the graph.
+        \param weights: Weight list of the graph.
+        \param nodeCount: Number of nodes of the graph.
+        \param rows: Number of JL projections.
+        \param scale: square root of Scale will divide the value of the JL Matrix.
+        \param tolProb: Tolerance threshold value between 0.0 and 1.0.
+        \param seed: Seed identifying the projection matrix.
+        \return A (nodeCount x rows) matrix. Column i is the i-th projected right-hand side.
+        */
+        template <typename EdgeType, typename WeightType>
+        inline gSparse::PrecisionMatrix
+            implicitProjection(const EdgeType & edges,
+                const WeightType & weights,
+                std::size_t nodeCount,
+                std::size_t rows,
+                double scale,
+                double tolProb,
+                std::uint64_t seed)
+        {
+            #ifndef NDEBUG
+                assert (tolProb <= 1.0f);
+                assert (tolProb >= 0.0f);
+                assert (scale != 0.0f);
+                assert (rows > 0 );
+            #endif
+
+            // Accumulate in row-major order so both endpoints of an edge touch contiguous memory
+            gSparse::PrecisionRowMatrix Y = gSparse::PrecisionRowMatrix::Zero(nodeCount, rows);
+            for (Eigen::Index e = 0; e != edges.rows(); ++e)
+            {
+                const std::size_t u = static_cast<std::size_t>(edges(e, 0));
+                const std::size_t v = static_cast<std::size_t>(edges(e, 1));
+                if (u == v) continue;
+                const gSparse::PRECISION sqrtWeight = std::sqrt(weights(e, 0));
+                for (std::size_t r = 0; r != rows; ++r)
+                {
+                    const gSparse::PRECISION q = sqrtWeight *
+                        implicitProjectionEntry(r, static_cast<std::size_t>(e), scale, tolProb, seed);
+                    Y(u, r) += q;
+                    Y(v, r) -= q;
+                }
+            }
+            return Y;
+        }
     }
 }
 
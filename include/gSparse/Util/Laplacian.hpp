@@ -0,0 +1,349 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_UTIL_LAPLACIAN_HPP
+#define GSPARSE_UTIL_LAPLACIAN_HPP
+
+#include "../Config.hpp"
+#include "Parallel.hpp"  // Worker threads
+#include <Eigen/Sparse>
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <cassert>
+
+namespace gSparse
+{
+    namespace Util
+    {
+        //! assembleLaplacian builds the Laplacian of a weighted edge list directly in compressed column storage.
+        /*!
+            Neither the degree and adjacency matrices nor a triplet list are formed. One pass counts the entries of
+            each column, a prefix sum gives the column offsets, and a second pass scatters the off-diagonal entries
+            and accumulates the degrees on the diagonal. Each column is then sorted and its duplicate edges summed,
+            in parallel over columns.
+            Every node has a diagonal entry, which is an explicit zero for isolated nodes. Self-loops are ignored,
+            as they do not change the Laplacian.
+        \param edges: An m x 2 matrix of node indices.
+        \param weights: An m x 1 matrix of edge weights.
+        \param nodeCount: Number of nodes. Every node index must be smaller.
+        \param laplacian: A sparse matrix to receive the Laplacian, with both lower and upper parts stored.
+        \param threadCount: Number of threads to sort columns. Zero means one thread per hardware thread.
+        */
+        template <typename EdgeType, typename WeightType>
+        inline void assembleLaplacian(const Eigen::MatrixBase<EdgeType> & edges,
+            const Eigen::MatrixBase<WeightType> & weights,
+            Eigen::Index nodeCount,
+            gSparse::SparsePrecisionMatrix & laplacian,
+            std::size_t threadCount = 0)
+        {
+            typedef gSparse::SparsePrecisionMatrix::StorageIndex StorageIndex;
+            const Eigen::Index edgeCount = edges.rows();
+            #ifndef NDEBUG
+                assert(edges.cols() == 2);
+                assert(weights.rows() == edgeCount);
+                assert(static_cast<double>(2 * edgeCount + nodeCount) < static_cast<double>(Eigen::NumTraits<StorageIndex>::highest()));
+            #endif
+
+            laplacian = gSparse::SparsePrecisionMatrix(nodeCount, nodeCount);
+            StorageIndex * outer = laplacian.outerIndexPtr();
+
+            // Count the entries of each column: the diagonal and one per incident edge
+            for (Eigen::Index j = 0; j != nodeCount; ++j) outer[j + 1] = 1;
+            for (Eigen::Index i = 0; i != edgeCount; ++i)
+            {
+                const Eigen::Index r = static_cast<Eigen::Index>(edges(i, 0));
+                const Eigen::Index c = static_cast<Eigen::Index>(edges(i, 1));
+                #ifndef NDEBUG
+                    assert(r >= 0 && r < nodeCount && c >= 0 && c < nodeCount);
+                #endif
+                if (r == c) continue;
+                ++outer[r + 1];
+                ++outer[c + 1];
+            }
+            for (Eigen::Index j = 0; j != nodeCount; ++j) outer[j + 1] += outer[j];
+            laplacian.resizeNonZeros(outer[nodeCount]);
+            StorageIndex * inner = laplacian.innerIndexPtr();
+            gSparse::PRECISION * values = laplacian.valuePtr();
+
+            // The diagonal is the first entry of each column until the columns are sorted
+            std::vector<StorageIndex> next(outer, outer + nodeCount);
+            for (Eigen::Index j = 0; j != nodeCount; ++j)
+            {
+                inner[next[j]] = static_cast<StorageIndex>(j);
+                values[next[j]++] = 0;
+            }
+            for (Eigen::Index i = 0; i != edgeCount; ++i)
+            {
+                const Eigen::Index r = static_cast<Eigen::Index>(edges(i, 0));
+                const Eigen::Index c = static_cast<Eigen::Index>(edges(i, 1));
+                if (r == c) continue;
+                const gSparse::PRECISION w = static_cast<gSparse::PRECISION>(weights(i, 0));
+                values[outer[r]] += w;
+                values[outer[c]] += w;
+                inner[next[r]] = static_cast<StorageIndex>(c);
+                values[next[r]++] = -w;
+                inner[next[c]] = static_cast<StorageIndex>(r);
+                values[next[c]++] = -w;
+            }
+
+            // Sort each column and sum duplicate edges. next[j] receives the end of the merged column.
+            const std::size_t minNonZeros = 65536;
+            threadCount = std::min(resolveThreadCount(threadCount),
+                static_cast<std::size_t>(laplacian.nonZeros()) / minNonZeros + 1);
+            parallelFor(0, static_cast<std::size_t>(nodeCount), threadCount, [&](std::size_t first, std::size_t last)
+            {
+                std::vector<std::pair<StorageIndex, gSparse::PRECISION>> column;
+                for (std::size_t j = first; j != last; ++j)
+                {
+                    const StorageIndex begin = outer[j];
+                    const StorageIndex end = outer[j + 1];
+                    // Edge lists are often ordered, so the off-diagonal entries may already be strictly increasing.
+                    // Then only the diagonal needs to move into place.
+                    if (std::adjacent_find(inner + begin + 1, inner + end, std::greater_equal<StorageIndex>()) == inner + end)
+                    {
+                        const gSparse::PRECISION diagonal = values[begin];
+                        StorageIndex k = begin;
+                        for (; k + 1 != end && inner[k + 1] < static_cast<StorageIndex>(j); ++k)
+                        {
+                            inner[k] = inner[k + 1];
+                            values[k] = values[k + 1];
+                        }
+                        inner[k] = static_cast<StorageIndex>(j);
+                        values[k] = diagonal;
+                        next[j] = end;
+                        continue;
+                    }
+                    column.clear();
+                    for (StorageIndex k = begin; k != end; ++k)
+                        column.push_back(std::make_pair(inner[k], values[k]));
+                    std::sort(column.begin(), column.end(),
+                        [](const std::pair<StorageIndex, gSparse::PRECISION> & a, const std::pair<StorageIndex, gSparse::PRECISION> & b)
+                        { return a.first < b.first; });
+                    StorageIndex k = begin;
+                    for (std::size_t e = 0; e != column.size(); ++e)
+                    {
+                        if (k != begin && inner[k - 1] == column[e].first)
+                        {
+                            values[k - 1] += column[e].second;
+                            continue;
+                        }
+                        inner[k] = column[e].first;
+                        values[k++] = column[e].second;
+                    }
+                    next[j] = k;
+                }
+            });
+
+            // Close the gaps left by duplicate edges
+            StorageIndex write = 0;
+            for (Eigen::Index j = 0; j != nodeCount; ++j)
+            {
+                const StorageIndex begin = outer[j];
+                outer[j] = write;
+                for (StorageIndex k = begin; k != next[j]; ++k, ++write)
+                {
+                    inner[write] = inner[k];
+                    values[write] = values[k];
+                }
+            }
+            if (write != outer[nodeCount])
+            {
+                outer[nodeCount] = write;
+                laplacian.resizeNonZeros(write);
+                laplacian.data().squeeze();
+            }
+        }
+
+        //! connectedComponents labels the connected components of a graph Laplacian.
+        /*!
+            Components are found with a union-find over the off-diagonal entries.
+            Each node is labelled with the smallest node of its component.
+        \param laplacian: A symmetric Laplacian matrix. Both lower and upper parts must be stored.
+        \param component: Receives the label of each node.
+        */
+        template <typename MatType>
+        inline void connectedComponents(const MatType & laplacian, std::vector<Eigen::Index> & component)
+        {
+            const Eigen::Index n = laplacian.cols();
+            component.resize(n);
+            for (Eigen::Index i = 0; i != n; ++i) component[i] = i;
+            auto findRoot = [&component](Eigen::Index x)
+            {
+                while (component[x] != x)
+                {
+                    component[x] = component[component[x]];
+                    x = component[x];
+                }
+                return x;
+            };
+            for (Eigen::Index j = 0; j != laplacian.outerSize(); ++j)
+            {
+                for (typename MatType::InnerIterator it(laplacian, j); it; ++it)
+                {
+                    if (it.value() == 0) continue;
+                    Eigen::Index a = findRoot(it.row());
+                    Eigen::Index b = findRoot(it.col());
+                    // Always keep the smallest node of a component as its root
+                    if (a < b) component[b] = a;
+                    else if (b < a) component[a] = b;
+                }
+            }
+            // Roots precede their members, so one pass flattens every path
+            for (Eigen::Index i = 0; i != n; ++i) component[i] = component[component[i]];
+        }
+
+        //! removeComponentMean shifts a vector to zero mean on every connected component.
+        /*!
+            This is the orthogonal projection onto the range of a Laplacian with the given components.
+        \param x: The vector to project.
+        \param component: Component labels from connectedComponents().
+        */
+        inline void removeComponentMean(gSparse::PrecisionVector & x, const std::vector<Eigen::Index> & component)
+        {
+            const std::size_t n = component.size();
+            std::vector<gSparse::PRECISION> sum(n, 0);
+            std::vector<std::size_t> count(n, 0);
+            for (std::size_t i = 0; i != n; ++i)
+            {
+                sum[component[i]] += x(i);
+                ++count[component[i]];
+            }
+            for (std::size_t i = 0; i != n; ++i)
+                x(i) -= sum[component[i]] / static_cast<gSparse::PRECISION>(count[component[i]]);
+        }
+
+        //! groundLaplacian removes one node per connected component from a graph Laplacian.
+        /*!
+            A graph Laplacian is singular, with one null vector per connected component.
+            Grounding (fixing the potential of) one node per component yields a symmetric positive definite
+            system that can be factorized by a direct solver. The potential of grounded nodes is zero.
+        \param laplacian: A symmetric Laplacian matrix. Both lower and upper parts must be stored.
+        \param grounded: A sparse matrix to receive the grounded Laplacian.
+        \param reducedIndex: Receives the row of each node in the grounded Laplacian, or -1 if the node is grounded.
+        */
+        template <typename MatType>
+        inline void groundLaplacian(const MatType & laplacian,
+            gSparse::SparsePrecisionMatrix & grounded,
+            std::vector<Eigen::Index> & reducedIndex)
+        {
+            const Eigen::Index n = laplacian.cols();
+            std::vector<Eigen::Index> component;
+            connectedComponents(laplacian, component);
+
+            // The root of each component is grounded. Remaining nodes are renumbered in order.
+            reducedIndex.assign(n, -1);
+            Eigen::Index reducedCount = 0;
+            for (Eigen::Index i = 0; i != n; ++i)
+            {
+                if (component[i] != i)
+                    reducedIndex[i] = reducedCount++;
+            }
+
+            // Copy the entries of non-grounded rows and columns
+            std::vector<Eigen::Triplet<gSparse::PRECISION>> entries;
+            entries.reserve(static_cast<std::size_t>(laplacian.nonZeros()));
+            for (Eigen::Index j = 0; j != laplacian.outerSize(); ++j)
+            {
+                for (typename MatType::InnerIterator it(laplacian, j); it; ++it)
+                {
+                    Eigen::Index r = reducedIndex[it.row()];
+                    Eigen::Index c = reducedIndex[it.col()];
+                    if (r >= 0 && c >= 0)
+                        entries.push_back(Eigen::Triplet<gSparse::PRECISION>(r, c, it.value()));
+                }
+            }
+            grounded = gSparse::SparsePrecisionMatrix(reducedCount, reducedCount);
+            grounded.setFromTriplets(entries.begin(), entries.end());
+        }
+
+        //! copyLaplacian copies a symmetric matrix into a gSparse::SparsePrecisionMatrix.
+        /*!
+            Works with any sparse type that provides an InnerIterator, regardless of its storage order.
+        \param laplacian: A symmetric Laplacian matrix. Both lower and upper parts must be stored.
+        \param result: A sparse matrix to receive the copy.
+        */
+        template <typename MatType>
+        inline void copyLaplacian(const MatType & laplacian, gSparse::SparsePrecisionMatrix & result)
+        {
+            std::vector<Eigen::Triplet<gSparse::PRECISION>> entries;
+            entries.reserve(static_cast<std::size_t>(laplacian.nonZeros()));
+            for (Eigen::Index j = 0; j != laplacian.outerSize(); ++j)
+            {
+                for (typename MatType::InnerIterator it(laplacian, j); it; ++it)
+                    entries.push_back(Eigen::Triplet<gSparse::PRECISION>(it.row(), it.col(), it.value()));
+            }
+            result = gSparse::SparsePrecisionMatrix(laplacian.rows(), laplacian.cols());
+            result.setFromTriplets(entries.begin(), entries.end());
+        }
+
+        //! A direct solver for singular graph Laplacians.
+        /*!
+            GroundedSolver grounds one node per connected component of the Laplacian and factorizes
+            the remaining symmetric positive definite system with Solver. Solutions of solve() are zero at grounded nodes.
+            projectedSolve() instead works in the range of the Laplacian, which keeps it symmetric when used as a preconditioner.
+            Solver can be any Eigen sparse solver such as Eigen::SimplicialLDLT or Eigen::IncompleteCholesky.
+        */
+        template <typename Solver>
+        class GroundedSolver
+        {
+        public:
+            //! Ground and factorize a Laplacian. Returns Eigen::Success on success.
+            template <typename MatType>
+            inline Eigen::ComputationInfo compute(const MatType & laplacian)
+            {
+                gSparse::SparsePrecisionMatrix grounded;
+                groundLaplacian(laplacian, grounded, _reducedIndex);
+                connectedComponents(laplacian, _component);
+                _reducedCount = grounded.rows();
+                if (_reducedCount == 0)
+                    return Eigen::Success;
+                _solver.compute(grounded);
+                return _solver.info();
+            }
+            //! Solve L x = b. Entries of b at grounded nodes are ignored.
+            template <typename Rhs>
+            inline gSparse::PrecisionVector solve(const Eigen::MatrixBase<Rhs> & b) const
+            {
+                const Eigen::Index n = static_cast<Eigen::Index>(_reducedIndex.size());
+                gSparse::PrecisionVector x = gSparse::PrecisionVector::Zero(n);
+                if (_reducedCount == 0)
+                    return x;
+                gSparse::PrecisionVector reducedB(_reducedCount);
+                for (Eigen::Index i = 0; i != n; ++i)
+                {
+                    if (_reducedIndex[i] >= 0) reducedB(_reducedIndex[i]) = b(i);
+                }
+                gSparse::PrecisionVector reducedX = _solver.solve(reducedB);
+                for (Eigen::Index i = 0; i != n; ++i)
+                {
+                    if (_reducedIndex[i] >= 0) x(i) = reducedX(_reducedIndex[i]);
+                }
+                return x;
+            }
+            //! Solve L x = b with b and x projected to zero mean on every connected component.
+            template <typename Rhs>
+            inline gSparse::PrecisionVector projectedSolve(const Eigen::MatrixBase<Rhs> & b) const
+            {
+                gSparse::PrecisionVector rhs = b;
+                removeComponentMean(rhs, _component);
+                gSparse::PrecisionVector x = solve(rhs);
+                removeComponentMean(x, _component);
+                return x;
+            }
+            //! Component label of each node, as computed by connectedComponents()
+            inline const std::vector<Eigen::Index> & components() const { return _component; }
+        private:
+            Solver _solver;                           //!< Solver of the grounded system
+            std::vector<Eigen::Index> _reducedIndex;  //!< Row of each node in the grounded system, -1 if grounded
+            std::vector<Eigen::Index> _component;     //!< Connected component of each node
+            Eigen::Index _reducedCount = 0;           //!< Size of the grounded system
+        };
+    }
+}
+
+#endif
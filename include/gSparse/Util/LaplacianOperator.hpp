@@ -0,0 +1,211 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_UTIL_LAPLACIANOPERATOR_HPP
+#define GSPARSE_UTIL_LAPLACIANOPERATOR_HPP
+
+#include "../Config.hpp"
+#include "Parallel.hpp"  // Worker threads
+
+#include <Eigen/Sparse>
+
+#include <vector>
+#include <memory>     // Shared_ptr
+#include <algorithm>
+#include <cassert>
+
+namespace gSparse
+{
+    namespace Util
+    {
+        template <typename Scalar_, typename StorageScalar_ = Scalar_>
+        class BasicLaplacianOperator;
+    }
+}
+
+namespace Eigen
+{
+    namespace internal
+    {
+        //! BasicLaplacianOperator behaves as a row-major sparse matrix in Eigen expressions
+        template <typename Scalar_, typename StorageScalar_>
+        struct traits<gSparse::Util::BasicLaplacianOperator<Scalar_, StorageScalar_>> :
+            public Eigen::internal::traits<Eigen::SparseMatrix<Scalar_, Eigen::RowMajor>>
+        {};
+    }
+}
+
+namespace gSparse
+{
+    namespace Util
+    {
+        //! A multithreaded matrix-free operator for a symmetric graph Laplacian.
+        /*!
+            A column-major Laplacian is symmetric, so its compressed columns are also the compressed (CSR) rows of
+            the same matrix. LaplacianOperator computes L * x row by row on those arrays. Rows are partitioned
+            across threads so that every thread processes the same number of non-zeros, and every thread writes
+            a disjoint slice of the result. Eigen's product of a column-major sparse matrix and a vector
+            scatters into the result and runs on a single thread.
+            The threads are started once by the operator and reused by every product (see gSparse::Util::WorkerPool).
+            A product with several columns applies L to one column at a time.
+
+            LaplacianOperator can be used as the matrix of Eigen::ConjugateGradient with Eigen::Lower | Eigen::Upper.
+            It provides an InnerIterator, so Eigen::DiagonalPreconditioner and the preconditioners of
+            gSparse::Preconditioner can be computed from it.
+
+            LaplacianOperator keeps a reference to the Laplacian, which must outlive it.
+            Scalar_ is the scalar type of the vectors and of the arithmetic. StorageScalar_ is the scalar type of the stored
+            Laplacian. A float Laplacian applied in double moves fewer bytes per product while every sum is accumulated in double.
+            gSparse::Util::LaplacianOperator applies a gSparse::SparsePrecisionMatrix.
+        */
+        template <typename Scalar_, typename StorageScalar_>
+        class BasicLaplacianOperator : public Eigen::EigenBase<BasicLaplacianOperator<Scalar_, StorageScalar_>>
+        {
+        public:
+            typedef Scalar_ Scalar;
+            typedef Scalar_ RealScalar;
+            typedef Eigen::SparseMatrix<StorageScalar_> MatrixType;
+            typedef typename MatrixType::StorageIndex StorageIndex;
+            enum
+            {
+                ColsAtCompileTime = Eigen::Dynamic,
+                MaxColsAtCompileTime = Eigen::Dynamic,
+                IsRowMajor = true
+            };
+
+            //! Iterates over the non-zeros of a row. Rows and columns are interchangeable as L is symmetric.
+            class InnerIterator : public MatrixType::InnerIterator
+            {
+            public:
+                InnerIterator(const BasicLaplacianOperator & op, Eigen::Index outer)
+                    : MatrixType::InnerIterator(*op._laplacian, outer), _outer(outer) {}
+                //! Row of the current entry
+                inline Eigen::Index row() const { return _outer; }
+                //! Column of the current entry
+                inline Eigen::Index col() const { return this->index(); }
+            private:
+                Eigen::Index _outer;
+            };
+
+            /// Construct an operator for a Laplacian.
+            /// \param laplacian A symmetric Laplacian in compressed storage. Both lower and upper parts must be stored.
+            /// \param threadCount Number of threads. Default is 0, which uses every hardware thread.
+            explicit BasicLaplacianOperator(const MatrixType & laplacian, std::size_t threadCount = 0)
+                : _laplacian(&laplacian)
+            {
+                #ifndef NDEBUG
+                    assert(laplacian.isCompressed());
+                    assert(laplacian.rows() == laplacian.cols());
+                #endif
+                SetThreadCount(threadCount);
+            }
+
+            /// Set number of threads, rebalance the row partition and restart the worker threads.
+            /// Each thread is given at least 65536 non-zeros, so small Laplacians use fewer threads.
+            /// Handing a product to the worker threads costs about 5-10 microseconds, while a thread
+            /// processes a non-zero in 1-3 nanoseconds, so smaller parts would spend much of a product waiting.
+            /// \param threadCount Number of threads. Zero uses every hardware thread.
+            inline void SetThreadCount(std::size_t threadCount)
+            {
+                const Eigen::Index n = rows();
+                const std::size_t nonZeroCount = static_cast<std::size_t>(nonZeros());
+                const std::size_t minNonZeros = 65536;
+                std::size_t parts = resolveThreadCount(threadCount);
+                parts = std::max<std::size_t>(1, std::min(parts, nonZeroCount / minNonZeros));
+
+                // Part p starts at the first row whose non-zeros begin at or after p * nnz / parts
+                const StorageIndex * outer = _laplacian->outerIndexPtr();
+                _partition.assign(1, 0);
+                for (std::size_t p = 1; p < parts; ++p)
+                {
+                    const StorageIndex target = static_cast<StorageIndex>(nonZeroCount * p / parts);
+                    const Eigen::Index row = std::lower_bound(outer, outer + n, target) - outer;
+                    if (row > _partition.back() && row < n) _partition.push_back(row);
+                }
+                _partition.push_back(n);
+                if (!_pool || _pool->GetThreadCount() != _partition.size() - 1)
+                    _pool = std::make_shared<WorkerPool>(_partition.size() - 1);
+            }
+            /// Get number of threads used by a product.
+            inline std::size_t GetThreadCount() const { return _partition.size() - 1; }
+
+            inline Eigen::Index rows() const { return _laplacian->rows(); }
+            inline Eigen::Index cols() const { return _laplacian->cols(); }
+            inline Eigen::Index outerSize() const { return _laplacian->outerSize(); }
+            inline Eigen::Index nonZeros() const { return _laplacian->nonZeros(); }
+            //! The Laplacian this operator applies
+            inline const MatrixType & matrix() const { return *_laplacian; }
+
+            //! Lazy product with a dense vector or matrix, evaluated by multiply()
+            template <typename Rhs>
+            inline Eigen::Product<BasicLaplacianOperator, Rhs, Eigen::AliasFreeProduct> operator*(const Eigen::MatrixBase<Rhs> & x) const
+            {
+                return Eigen::Product<BasicLaplacianOperator, Rhs, Eigen::AliasFreeProduct>(*this, x.derived());
+            }
+
+            //! Compute dst += alpha * L * rhs. dst and rhs must not alias.
+            template <typename Dest, typename Rhs>
+            inline void multiply(Dest & dst, const Rhs & rhs, Scalar alpha) const
+            {
+                const StorageIndex * outer = _laplacian->outerIndexPtr();
+                const StorageIndex * inner = _laplacian->innerIndexPtr();
+                const StorageScalar_ * values = _laplacian->valuePtr();
+                _pool->Run([&](std::size_t part)
+                {
+                    for (Eigen::Index j = 0; j != rhs.cols(); ++j)
+                    {
+                        for (Eigen::Index i = _partition[part]; i != _partition[part + 1]; ++i)
+                        {
+                            // Four partial sums shorten the chain of dependent additions
+                            Scalar s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+                            StorageIndex k = outer[i];
+                            const StorageIndex end = outer[i + 1];
+                            for (; k + 3 < end; k += 4)
+                            {
+                                s0 += Scalar(values[k]) * rhs.coeff(inner[k], j);
+                                s1 += Scalar(values[k + 1]) * rhs.coeff(inner[k + 1], j);
+                                s2 += Scalar(values[k + 2]) * rhs.coeff(inner[k + 2], j);
+                                s3 += Scalar(values[k + 3]) * rhs.coeff(inner[k + 3], j);
+                            }
+                            for (; k < end; ++k)
+                                s0 += Scalar(values[k]) * rhs.coeff(inner[k], j);
+                            dst.coeffRef(i, j) += alpha * ((s0 + s1) + (s2 + s3));
+                        }
+                    }
+                });
+            }
+        private:
+            const MatrixType * _laplacian;          //!< Laplacian in compressed column storage
+            std::vector<Eigen::Index> _partition;  //!< First row of each thread, followed by the row count
+            std::shared_ptr<WorkerPool> _pool;     //!< One thread per part, shared by copies of the operator
+        };
+
+        //! A multithreaded matrix-free operator for a gSparse::SparsePrecisionMatrix Laplacian
+        typedef BasicLaplacianOperator<gSparse::PRECISION> LaplacianOperator;
+    }
+}
+
+namespace Eigen
+{
+    namespace internal
+    {
+        //! Evaluates BasicLaplacianOperator * dense with BasicLaplacianOperator::multiply
+        template <typename Scalar_, typename StorageScalar_, typename Rhs, int ProductType>
+        struct generic_product_impl<gSparse::Util::BasicLaplacianOperator<Scalar_, StorageScalar_>, Rhs, SparseShape, DenseShape, ProductType>
+            : generic_product_impl_base<gSparse::Util::BasicLaplacianOperator<Scalar_, StorageScalar_>, Rhs,
+                generic_product_impl<gSparse::Util::BasicLaplacianOperator<Scalar_, StorageScalar_>, Rhs, SparseShape, DenseShape, ProductType>>
+        {
+            typedef typename Product<gSparse::Util::BasicLaplacianOperator<Scalar_, StorageScalar_>, Rhs>::Scalar Scalar;
+
+            template <typename Dest>
+            static inline void scaleAndAddTo(Dest & dst, const gSparse::Util::BasicLaplacianOperator<Scalar_, StorageScalar_> & lhs, const Rhs & rhs, const Scalar & alpha)
+            {
+                const typename nested_eval<Rhs, 1>::type actualRhs(rhs);
+                lhs.multiply(dst, actualRhs, alpha);
+            }
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,105 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_UTIL_LINEREADER_HPP
+#define GSPARSE_UTIL_LINEREADER_HPP
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstring>     // memchr, memmove
+
+namespace gSparse
+{
+    namespace Util
+    {
+        //! A text file read line by line through a fixed-size block.
+        /*!
+            Unlike MappedFile, only one block of the file is held in memory, which suits files larger than memory.
+            The block grows only for lines longer than itself.
+        */
+        class LineReader
+        {
+        public:
+            //! Constructor
+            /*!
+            \param path: File to read.
+            \param blockBytes: Size of the block read at once. Default is 1 MiB.
+            */
+            LineReader(const std::string & path, std::size_t blockBytes = 1 << 20) :
+                _file(path.c_str(), std::ios::binary),
+                _buffer(blockBytes > 0 ? blockBytes : 1)
+            {}
+            LineReader(const LineReader &) = delete;
+            LineReader & operator=(const LineReader &) = delete;
+
+            //! Whether the file was opened
+            inline bool is_open() const { return _file.is_open(); }
+            //! Find the next line.
+            /*!
+            \param begin: Receives the start of the line. It stays valid until the next call.
+            \param end: Receives the end of the line, before its newline.
+            \return false at the end of the file.
+            */
+            inline bool next(const char *& begin, const char *& end)
+            {
+                for (;;)
+                {
+                    const char * data = _buffer.data();
+                    const void * newline = std::memchr(data + _begin, '\n', _end - _begin);
+                    if (newline != nullptr)
+                    {
+                        begin = data + _begin;
+                        end = static_cast<const char *>(newline);
+                        _begin = static_cast<std::size_t>(end - data) + 1;
+                        return true;
+                    }
+                    if (_eof)
+                    {
+                        // A last line without a newline
+                        if (_begin == _end) return false;
+                        begin = data + _begin;
+                        end = data + _end;
+                        _begin = _end;
+                        return true;
+                    }
+                    _fill();
+                }
+            }
+            //! Start reading again from the first line
+            inline void rewind()
+            {
+                _file.clear();
+                _file.seekg(0);
+                _begin = _end = 0;
+                _eof = false;
+            }
+        private:
+            std::ifstream _file;          //!< Input file
+            std::vector<char> _buffer;    //!< Block of the file
+            std::size_t _begin = 0;       //!< Start of the unread part of the block
+            std::size_t _end = 0;         //!< End of the data in the block
+            bool _eof = false;            //!< Whether the whole file has been read into the block
+
+            //! Keep the unread part of the block and read more of the file after it
+            inline void _fill()
+            {
+                if (_begin != 0)
+                {
+                    std::memmove(_buffer.data(), _buffer.data() + _begin, _end - _begin);
+                    _end -= _begin;
+                    _begin = 0;
+                }
+                if (_end == _buffer.size()) _buffer.resize(_buffer.size() * 2);
+                _file.read(_buffer.data() + _end, static_cast<std::streamsize>(_buffer.size() - _end));
+                const std::streamsize count = _file.gcount();
+                _end += static_cast<std::size_t>(count);
+                if (count == 0 || !_file) _eof = true;
+            }
+        };
+    }
+}
+
+#endif
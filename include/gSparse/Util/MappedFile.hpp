@@ -0,0 +1,108 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_UTIL_MAPPEDFILE_HPP
+#define GSPARSE_UTIL_MAPPEDFILE_HPP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#if defined(_WIN32)
+    #include <fstream>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace gSparse
+{
+    namespace Util
+    {
+        //! A read-only view of a whole file.
+        /*!
+            On POSIX systems the file is memory-mapped, so its pages are read by the kernel on demand and are never copied
+            into a user buffer. Elsewhere the file is read into memory. The contents are not null-terminated.
+        */
+        class MappedFile
+        {
+        public:
+            MappedFile() = default;
+            MappedFile(const MappedFile &) = delete;
+            MappedFile & operator=(const MappedFile &) = delete;
+            ~MappedFile() { close(); }
+
+            //! Map a file. Returns false if the file cannot be opened or mapped.
+            /*!
+            \param path: Path of the file.
+            */
+            inline bool open(const std::string & path)
+            {
+                close();
+            #if defined(_WIN32)
+                std::ifstream file(path, std::ios::binary | std::ios::ate);
+                if (!file.is_open()) return false;
+                _buffer.resize(static_cast<std::size_t>(file.tellg()));
+                file.seekg(0);
+                if (!_buffer.empty() && !file.read(&_buffer[0], static_cast<std::streamsize>(_buffer.size()))) return false;
+                _data = _buffer.empty() ? nullptr : &_buffer[0];
+                _size = _buffer.size();
+                return true;
+            #else
+                int descriptor = ::open(path.c_str(), O_RDONLY);
+                if (descriptor < 0) return false;
+                struct stat status;
+                if (::fstat(descriptor, &status) != 0 || !S_ISREG(status.st_mode))
+                {
+                    ::close(descriptor);
+                    return false;
+                }
+                _size = static_cast<std::size_t>(status.st_size);
+                if (_size != 0)
+                {
+                    void * address = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+                    if (address == MAP_FAILED)
+                    {
+                        ::close(descriptor);
+                        _size = 0;
+                        return false;
+                    }
+                    // Files are scanned front to back, so read ahead aggressively
+                    ::madvise(address, _size, MADV_SEQUENTIAL);
+                    _data = static_cast<const char *>(address);
+                }
+                ::close(descriptor);
+                return true;
+            #endif
+            }
+            //! Unmap the file
+            inline void close()
+            {
+            #if defined(_WIN32)
+                std::vector<char>().swap(_buffer);
+            #else
+                if (_data != nullptr) ::munmap(const_cast<char *>(_data), _size);
+            #endif
+                _data = nullptr;
+                _size = 0;
+            }
+            //! First byte of the file, or nullptr if the file is empty
+            inline const char * data() const { return _data; }
+            //! One past the last byte of the file
+            inline const char * end() const { return _data + _size; }
+            //! Size of the file in bytes
+            inline std::size_t size() const { return _size; }
+        private:
+            const char * _data = nullptr;  //!< Mapped contents
+            std::size_t _size = 0;         //!< Size in bytes
+        #if defined(_WIN32)
+            std::vector<char> _buffer;     //!< Contents read into memory
+        #endif
+        };
+    }
+}
+
+#endif
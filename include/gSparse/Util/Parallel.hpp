@@ -0,0 +1,167 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_UTIL_PARALLEL_HPP
+#define GSPARSE_UTIL_PARALLEL_HPP
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <cstddef>
+
+namespace gSparse
+{
+    namespace Util
+    {
+        //! resolveThreadCount maps a requested thread count to the number of threads to run.
+        /*!
+        \param threadCount: Requested number of threads. Zero means one thread per hardware thread.
+        */
+        inline std::size_t resolveThreadCount(std::size_t threadCount)
+        {
+            if (threadCount == 0)
+                threadCount = static_cast<std::size_t>(std::thread::hardware_concurrency());
+            return threadCount > 0 ? threadCount : 1;
+        }
+
+        //! parallelFor splits a range into contiguous slices and processes each slice on its own thread.
+        /*!
+            The calling thread processes the first slice, and returns once every slice is done.
+            Slices are disjoint, so function may write to per-index outputs without synchronization.
+            function must not throw.
+        \param begin: First index of the range.
+        \param end: One past the last index of the range.
+        \param threadCount: Number of threads. Zero means one thread per hardware thread.
+        \param function: Callable as function(first, last) on the slice [first, last).
+        */
+        template <typename Function>
+        inline void parallelFor(std::size_t begin, std::size_t end, std::size_t threadCount, Function function)
+        {
+            if (end <= begin) return;
+            const std::size_t size = end - begin;
+            threadCount = resolveThreadCount(threadCount);
+            if (threadCount > size) threadCount = size;
+            if (threadCount == 1)
+            {
+                function(begin, end);
+                return;
+            }
+
+            // The first (size % threadCount) slices are one index longer
+            const std::size_t slice = size / threadCount;
+            const std::size_t remainder = size % threadCount;
+            std::vector<std::thread> workers;
+            workers.reserve(threadCount - 1);
+            std::size_t first = begin + slice + (remainder > 0 ? 1 : 0);
+            for (std::size_t t = 1; t != threadCount; ++t)
+            {
+                const std::size_t last = first + slice + (t < remainder ? 1 : 0);
+                workers.push_back(std::thread(function, first, last));
+                first = last;
+            }
+            function(begin, begin + slice + (remainder > 0 ? 1 : 0));
+            for (std::thread & worker : workers) worker.join();
+        }
+
+        //! A fixed set of worker threads that run one task after another.
+        /*!
+            parallelFor starts and joins its threads on every call, which costs tens of microseconds.
+            A WorkerPool starts its threads once, so a loop that dispatches many short tasks,
+            such as the Laplacian products of a CG solve, pays that cost only once.
+            Run is serialized: concurrent callers wait for each other.
+        */
+        class WorkerPool
+        {
+        public:
+            /// Start the worker threads.
+            /// \param threadCount Number of threads, including the thread calling Run. Zero means one per hardware thread.
+            explicit WorkerPool(std::size_t threadCount = 0) : _invoke(nullptr), _context(nullptr), _generation(0), _pending(0), _stop(false)
+            {
+                threadCount = resolveThreadCount(threadCount);
+                _workers.reserve(threadCount - 1);
+                for (std::size_t t = 1; t != threadCount; ++t)
+                    _workers.push_back(std::thread(&WorkerPool::_work, this, t));
+            }
+            WorkerPool(const WorkerPool &) = delete;
+            WorkerPool & operator=(const WorkerPool &) = delete;
+            //! Stop and join the worker threads
+            ~WorkerPool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _stop = true;
+                }
+                _wake.notify_all();
+                for (std::thread & worker : _workers) worker.join();
+            }
+
+            /// Get number of threads, including the thread calling Run.
+            inline std::size_t GetThreadCount() const { return _workers.size() + 1; }
+
+            /// Call function(t) once for every t in [0, GetThreadCount()), each on its own thread,
+            /// and return once every call is done. The calling thread runs t = 0. function must not throw.
+            template <typename Function>
+            inline void Run(Function function)
+            {
+                if (_workers.empty())
+                {
+                    function(0);
+                    return;
+                }
+                std::lock_guard<std::mutex> running(_runMutex);
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _invoke = &WorkerPool::_call<Function>;
+                    _context = &function;
+                    _pending = _workers.size();
+                    ++_generation;
+                }
+                _wake.notify_all();
+                function(0);
+                std::unique_lock<std::mutex> lock(_mutex);
+                _done.wait(lock, [this]() { return _pending == 0; });
+            }
+        private:
+            std::vector<std::thread> _workers;        //!< Threads 1 to GetThreadCount() - 1
+            std::mutex _runMutex;                     //!< Serializes Run
+            std::mutex _mutex;                        //!< Guards the fields below
+            std::condition_variable _wake;            //!< Signals a new task or stop
+            std::condition_variable _done;            //!< Signals that every worker finished the task
+            void (*_invoke)(void *, std::size_t);     //!< Calls the task of the current Run
+            void * _context;                          //!< Function of the current Run
+            std::size_t _generation;                  //!< Number of tasks dispatched
+            std::size_t _pending;                     //!< Workers still running the current task
+            bool _stop;                               //!< Set by the destructor
+
+            //! Type-erased call of the function passed to Run, without allocating
+            template <typename Function>
+            static void _call(void * context, std::size_t t) { (*static_cast<Function *>(context))(t); }
+
+            //! Loop of worker thread t
+            inline void _work(std::size_t t)
+            {
+                std::size_t seen = 0;
+                for (;;)
+                {
+                    void (*invoke)(void *, std::size_t);
+                    void * context;
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        _wake.wait(lock, [&]() { return _stop || _generation != seen; });
+                        if (_stop) return;
+                        seen = _generation;
+                        invoke = _invoke;
+                        context = _context;
+                    }
+                    invoke(context, t);
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (--_pending == 0) _done.notify_one();
+                }
+            }
+        };
+    }
+}
+
+#endif
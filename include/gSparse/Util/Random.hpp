@@ -0,0 +1,198 @@
+// Copyright (C) 2018 Thanaphon Chavengsaksongkram <as12production@gmail.com>, He Sun <he.sun@ed.ac.uk>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef GSPARSE_UTIL_RANDOM_HPP
+#define GSPARSE_UTIL_RANDOM_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <random>
+
+namespace gSparse
+{
+    namespace Util
+    {
+        //! mix64 is the SplitMix64 finalizer. It scrambles all bits of a 64-bit word.
+        inline std::uint64_t mix64(std::uint64_t z)
+        {
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        //! counterHash is a stateless counter-based random number generator.
+        /*!
+            The same (key, counter) pair always yields the same 64 random bits, so random values
+            can be generated on the fly, in any order and from any thread.
+        \param key: Key of the random stream, e.g. a seed.
+        \param counter: Position within the stream.
+        */
+        inline std::uint64_t counterHash(std::uint64_t key, std::uint64_t counter)
+        {
+            return mix64(counter * 0x9E3779B97F4A7C15ULL + mix64(key));
+        }
+
+        //! toUniform maps 64 random bits to a double uniformly distributed in [0, 1).
+        inline double toUniform(std::uint64_t bits)
+        {
+            return static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0);
+        }
+
+        //! toIndex maps 64 random bits to an integer uniformly distributed in [0, n).
+        /*!
+            Uses the upper bits of a 64 x 64 bit product, which is faster than a modulo and
+            has a bias below n / 2^64.
+        */
+        inline std::size_t toIndex(std::uint64_t bits, std::size_t n)
+        {
+            const std::uint64_t n64 = static_cast<std::uint64_t>(n);
+            // High 64 bits of bits * n from four 32 x 32 bit products
+            const std::uint64_t aLo = bits & 0xFFFFFFFFULL, aHi = bits >> 32;
+            const std::uint64_t bLo = n64 & 0xFFFFFFFFULL, bHi = n64 >> 32;
+            const std::uint64_t lolo = aLo * bLo, hilo = aHi * bLo, lohi = aLo * bHi, hihi = aHi * bHi;
+            const std::uint64_t cross = (lolo >> 32) + (hilo & 0xFFFFFFFFULL) + lohi;
+            return static_cast<std::size_t>(hihi + (hilo >> 32) + (cross >> 32));
+        }
+
+        //! philox4x32 is the Philox4x32-10 counter-based block cipher of Salmon et al.
+        /*!
+            Random123: Parallel Random Numbers: As Easy as 1, 2, 3 <https://doi.org/10.1145/2063384.2063405>
+            Encrypts a 128-bit counter with a 64-bit key into 128 random bits, in place.
+        \param counter: Four 32-bit words of the counter. Receives the random words.
+        \param key0: Lower 32 bits of the key.
+        \param key1: Upper 32 bits of the key.
+        */
+        inline void philox4x32(std::uint32_t counter[4], std::uint32_t key0, std::uint32_t key1)
+        {
+            for (int round = 0; round != 10; ++round)
+            {
+                const std::uint64_t p0 = static_cast<std::uint64_t>(0xD2511F53U) * counter[0];
+                const std::uint64_t p1 = static_cast<std::uint64_t>(0xCD9E8D57U) * counter[2];
+                const std::uint32_t c1 = counter[1];
+                const std::uint32_t c3 = counter[3];
+                counter[0] = static_cast<std::uint32_t>(p1 >> 32) ^ c1 ^ key0;
+                counter[1] = static_cast<std::uint32_t>(p1);
+                counter[2] = static_cast<std::uint32_t>(p0 >> 32) ^ c3 ^ key1;
+                counter[3] = static_cast<std::uint32_t>(p0);
+                key0 += 0x9E3779B9U;
+                key1 += 0xBB67AE85U;
+            }
+        }
+
+        //! A reproducible stream of random numbers built on philox4x32.
+        /*!
+            A stream is identified by a seed and a stream id. Output number k of a stream is a pure function of
+            (seed, stream, k), so streams can be split per thread or per range of work without sharing state,
+            and seek() jumps to any position in constant time.
+            RandomStream satisfies the UniformRandomBitGenerator requirements and works with <random> distributions.
+        */
+        class RandomStream
+        {
+        public:
+            typedef std::uint64_t result_type;
+
+            /// Construct a stream.
+            /// \param seed Seed of the stream.
+            /// \param stream Identifier of an independent stream for the same seed. Default is 0.
+            explicit RandomStream(std::uint64_t seed, std::uint64_t stream = 0)
+                : _seed(seed), _stream(stream), _position(0) {}
+
+            static constexpr result_type min() { return 0; }
+            static constexpr result_type max() { return ~static_cast<result_type>(0); }
+
+            //! Next 64 random bits
+            inline result_type operator()()
+            {
+                // One block yields two outputs. Output k is half (k % 2) of block k / 2.
+                const std::uint64_t block = _position >> 1;
+                std::uint32_t counter[4] = {
+                    static_cast<std::uint32_t>(block), static_cast<std::uint32_t>(block >> 32),
+                    static_cast<std::uint32_t>(_stream), static_cast<std::uint32_t>(_stream >> 32) };
+                philox4x32(counter, static_cast<std::uint32_t>(_seed), static_cast<std::uint32_t>(_seed >> 32));
+                const unsigned half = static_cast<unsigned>(_position & 1) * 2;
+                ++_position;
+                return (static_cast<std::uint64_t>(counter[half + 1]) << 32) | counter[half];
+            }
+            //! Next double uniformly distributed in [0, 1)
+            inline double uniform() { return toUniform((*this)()); }
+            //! Next integer uniformly distributed in [0, n)
+            inline std::size_t index(std::size_t n) { return toIndex((*this)(), n); }
+
+            //! Jump to output number position of the stream
+            inline void seek(std::uint64_t position) { _position = position; }
+            //! Skip count outputs
+            inline void discard(std::uint64_t count) { _position += count; }
+            //! A stream with the same seed and a different id, e.g. one per thread
+            inline RandomStream substream(std::uint64_t stream) const { return RandomStream(_seed, stream); }
+
+            inline std::uint64_t seed() const { return _seed; }
+            inline std::uint64_t stream() const { return _stream; }
+            inline std::uint64_t position() const { return _position; }
+        private:
+            std::uint64_t _seed;      //!< Key of the cipher
+            std::uint64_t _stream;    //!< Upper half of the counter
+            std::uint64_t _position;  //!< Number of outputs drawn so far
+        };
+
+        //! State of the library-wide seed sequence
+        inline std::atomic<std::uint64_t> & _seedSequence()
+        {
+            static std::atomic<std::uint64_t> state(
+                (static_cast<std::uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}());
+            return state;
+        }
+
+        //! setGlobalSeed makes every default seed of the library reproducible.
+        /*!
+            Randomized components of gSparse (approximate effective resistance, sparsifiers, builders, samplers)
+            take their default seed from nextSeed(). After setGlobalSeed(s), the sequence of default seeds,
+            and hence every result, is the same on every run that creates components in the same order.
+            Without a call, default seeds come from std::random_device.
+        */
+        inline void setGlobalSeed(std::uint64_t seed)
+        {
+            _seedSequence().store(seed);
+        }
+
+        //! nextSeed returns the next default seed of the library-wide seed sequence. It is thread safe.
+        inline std::uint64_t nextSeed()
+        {
+            return mix64(_seedSequence().fetch_add(0x9E3779B97F4A7C15ULL) + 0x9E3779B97F4A7C15ULL);
+        }
+
+        //! deriveSeed derives independent seeds for the different random steps of one computation.
+        /*!
+        \param seed: Seed of the computation.
+        \param purpose: Identifier of the step.
+        */
+        inline std::uint64_t deriveSeed(std::uint64_t seed, std::uint64_t purpose)
+        {
+            return counterHash(seed, purpose + 1);
+        }
+
+        //! Calls object.SetSeed(seed). Chosen by overload resolution when object has SetSeed.
+        template <typename T>
+        inline auto _setSeed(T & object, std::uint64_t seed, int) -> decltype(object.SetSeed(seed), void())
+        {
+            object.SetSeed(seed);
+        }
+        //! Does nothing. Chosen when object has no SetSeed.
+        template <typename T>
+        inline void _setSeed(T &, std::uint64_t, long) {}
+
+        //! setSeedIfRandomized seeds a component, such as a preconditioner, that has a SetSeed member.
+        /*!
+            Components without SetSeed are deterministic and left unchanged, so templates can forward
+            their seed to any component type.
+        */
+        template <typename T>
+        inline void setSeedIfRandomized(T & object, std::uint64_t seed)
+        {
+            _setSeed(object, seed, 0);
+        }
+    }
+}
+
+#endif
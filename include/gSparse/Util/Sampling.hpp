@@ -6,7 +6,10 @@
 #define GSPARSE_UTIL_SAMPLING_HPP
 
 #include "../Config.hpp"
+#include "Random.hpp"
 #include <random>
+#include <vector>
+#include <cassert>
 
 namespace gSparse
 {
@@ -15,10 +18,12 @@ namespace gSparse
         /* 
 		Sample a number based from given discrete distribution
 		The pseudo random generateuses Mersenne Twister algorithm.
+		Each thread owns an engine seeded from gSparse::Util::nextSeed().
+		Pass a RandomStream to the overloads below for results that do not depend on threads.
 		*/
 		inline int sample(std::discrete_distribution<> & distribution)
 		{
-			thread_local std::mt19937 engine(std::random_device{}());
+			thread_local std::mt19937 engine(static_cast<std::mt19937::result_type>(gSparse::Util::nextSeed()));
 			return distribution(engine);
 		}
 
@@ -27,14 +32,130 @@ namespace gSparse
 		*/
 		inline double sample(std::uniform_real_distribution<> & distribution)
 		{
-			thread_local std::mt19937 engine(std::random_device{}());
+			thread_local std::mt19937 engine(static_cast<std::mt19937::result_type>(gSparse::Util::nextSeed()));
 			return distribution(engine);
 		}
 		inline double sample(std::uniform_int_distribution<> & distribution)
 		{
-			thread_local std::mt19937 engine(std::random_device{}());
+			thread_local std::mt19937 engine(static_cast<std::mt19937::result_type>(gSparse::Util::nextSeed()));
 			return distribution(engine);
 		}
+
+		/*
+		Sample from a distribution with a reproducible stream
+		*/
+		template <typename Distribution>
+		inline typename Distribution::result_type sample(Distribution & distribution, gSparse::Util::RandomStream & stream)
+		{
+			return distribution(stream);
+		}
+
+		//! A Walker alias table to sample a discrete distribution in constant time.
+		/*!
+			The table is built in O(n) with Vose's method. Each of the n columns holds a probability
+			and an alias: a draw picks a column uniformly, then keeps it or takes its alias.
+			A draw costs one random number and two array reads, regardless of n.
+		*/
+		class AliasTable
+		{
+		public:
+			//! Default constructor. The table is empty.
+			AliasTable() {}
+			/// Build the table from non-negative weights. Weights need not be normalized.
+			/// \param first Iterator to the first weight.
+			/// \param last Iterator past the last weight.
+			template <typename Iterator>
+			AliasTable(Iterator first, Iterator last) { build(first, last); }
+
+			/// Build the table from non-negative weights. Weights need not be normalized.
+			/// If every weight is zero, the table samples uniformly.
+			template <typename Iterator>
+			inline void build(Iterator first, Iterator last)
+			{
+				_probability.assign(first, last);
+				const std::size_t n = _probability.size();
+				_alias.resize(n);
+				double total = 0.0;
+				for (double w : _probability)
+				{
+					#ifndef NDEBUG
+						assert(w >= 0.0);
+					#endif
+					total += w;
+				}
+				if (!(total > 0.0))
+				{
+					_probability.assign(n, 1.0);
+					total = static_cast<double>(n);
+				}
+
+				// Scale so that the average column holds exactly 1, then pair small and large columns
+				std::vector<std::size_t> small, large;
+				for (std::size_t i = 0; i != n; ++i)
+				{
+					_probability[i] *= static_cast<double>(n) / total;
+					_alias[i] = i;
+					if (_probability[i] < 1.0) small.push_back(i);
+					else large.push_back(i);
+				}
+				while (!small.empty() && !large.empty())
+				{
+					std::size_t s = small.back(); small.pop_back();
+					std::size_t l = large.back();
+					_alias[s] = l;
+					_probability[l] -= 1.0 - _probability[s];
+					if (_probability[l] < 1.0)
+					{
+						large.pop_back();
+						small.push_back(l);
+					}
+				}
+				// Leftovers are 1 up to rounding
+				for (std::size_t i : large) _probability[i] = 1.0;
+				for (std::size_t i : small) _probability[i] = 1.0;
+			}
+
+			/// Draw an index with probability proportional to its weight.
+			/// \param engine A random engine producing 64-bit values, such as std::mt19937_64.
+			template <typename Engine>
+			inline std::size_t operator()(Engine & engine) const
+			{
+				return lookup(static_cast<std::uint64_t>(engine()));
+			}
+
+			/// Map 64 random bits to an index. The bits pick a column and decide between it and its alias.
+			inline std::size_t lookup(std::uint64_t bits) const
+			{
+				const double u = gSparse::Util::toUniform(bits) * static_cast<double>(_probability.size());
+				std::size_t column = static_cast<std::size_t>(u);
+				if (column >= _probability.size()) column = _probability.size() - 1;
+				return (u - static_cast<double>(column)) < _probability[column] ? column : _alias[column];
+			}
+
+			//! Number of outcomes
+			inline std::size_t size() const { return _probability.size(); }
+		private:
+			std::vector<double> _probability;  //!< Probability of keeping each column
+			std::vector<std::size_t> _alias;   //!< Alternative outcome of each column
+		};
+
+		/*
+		Sample an index from an alias table.
+		The pseudo random generator uses 64-bit Mersenne Twister algorithm.
+		*/
+		inline std::size_t sample(const AliasTable & table)
+		{
+			thread_local std::mt19937_64 engine(gSparse::Util::nextSeed());
+			return table(engine);
+		}
+
+		/*
+		Sample an index from an alias table with a reproducible stream.
+		*/
+		inline std::size_t sample(const AliasTable & table, gSparse::Util::RandomStream & stream)
+		{
+			return table.lookup(stream());
+		}
 		
     }
 }
@@ -4,20 +4,38 @@
 // Core
 #include "Config.hpp"
 #include "UndirectedGraph.hpp"
+#include "CompleteGraph.hpp"
 
 
 // IO
 #include "GraphCSVReader.hpp"
 #include "GraphCSVWriter.hpp"
+#include "GraphBinaryReader.hpp"
+#include "GraphBinaryWriter.hpp"
+#include "GraphCSVStreamReader.hpp"
+#include "GraphBinaryStreamReader.hpp"
+#include "GraphMatrixMarketReader.hpp"
+#include "GraphMatrixMarketWriter.hpp"
+#include "GraphSNAPReader.hpp"
+#include "GraphSNAPWriter.hpp"
+#include "GraphMETISReader.hpp"
+#include "GraphMETISWriter.hpp"
 
 // Sparsifiers
 #include "SpectralSparsifier/ERSampling.hpp"
+#include "SpectralSparsifier/StreamingERSampling.hpp"
 
 
 // Effective Resistances
 #include "ER/ApproximateER.hpp"
 #include "ER/ExactER.hpp"
 
+// Preconditioners
+#include "Preconditioner/IncompleteCholesky.hpp"
+#include "Preconditioner/SpanningTree.hpp"
+#include "Preconditioner/AggregationAMG.hpp"
+#include "Preconditioner/ApproximateCholesky.hpp"
+
 // Builders
 #include "Builder/CompleteGraph.hpp"
 